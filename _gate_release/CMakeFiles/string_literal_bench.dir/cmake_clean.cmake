@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/string_literal_bench.dir/bench/string_literal.cpp.o"
+  "CMakeFiles/string_literal_bench.dir/bench/string_literal.cpp.o.d"
+  "string_literal_bench"
+  "string_literal_bench.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/string_literal_bench.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
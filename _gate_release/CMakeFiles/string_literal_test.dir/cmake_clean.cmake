@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/string_literal_test.dir/test/string_literal.cpp.o"
+  "CMakeFiles/string_literal_test.dir/test/string_literal.cpp.o.d"
+  "string_literal_test"
+  "string_literal_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/string_literal_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,267 @@
+/* The MIT License (MIT)
+
+Copyright (c) 2016 jonathan poelen
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/**
+* \author    Jonathan Poelen <jonathan.poelen+falcon@gmail.com>
+* \version   1.0
+* \brief     Compile-time cost of string_literal.hpp constructs
+*
+* Usage: string_literal_compile_bench [scale [construct-filter]]
+*
+* Generates one translation unit per construct, compiles it with the
+* compiler of the build and reports the compilation time and the peak
+* resident memory of the compiler.
+*/
+
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <algorithm>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cerrno>
+
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <sys/resource.h>
+
+
+namespace
+{
+  struct construct
+  {
+    char const * name;
+    char const * description;
+    unsigned (*generate)(std::ostream & out, unsigned scale);
+  };
+
+  void header(std::ostream & out)
+  {
+    out <<
+      "#include \"falcon/container/string_literal.hpp\"\n"
+      "using namespace falcon::make_string_literal_shortcut;\n\n";
+  }
+
+  unsigned gen_baseline(std::ostream & out, unsigned /*scale*/)
+  {
+    header(out);
+    return 0;
+  }
+
+  /// literals of 256 different sizes
+  unsigned gen_literals(std::ostream & out, unsigned scale)
+  {
+    header(out);
+    unsigned const n = 2000 * scale;
+    for (unsigned i = 0; i < n; ++i) {
+      out << "constexpr auto l" << i << " = lit(\""
+        << std::string(i % 256, char('a' + i % 26)) << i << "\");\n";
+    }
+    return n;
+  }
+
+  /// a + b + c + ..., each operator+ creates a new type
+  unsigned gen_concat_chain(std::ostream & out, unsigned scale)
+  {
+    header(out);
+    unsigned const n = 200 * scale;
+    out << "constexpr auto c = lit(\"p0\")";
+    for (unsigned i = 1; i < n; ++i) {
+      out << "\n  + lit(\"p" << i << "\")";
+    }
+    out << ";\n";
+    return n;
+  }
+
+  /// concat(a, b, c, ...), for comparison with concat_chain
+  unsigned gen_concat_variadic(std::ostream & out, unsigned scale)
+  {
+    header(out);
+    unsigned const n = 200 * scale;
+    out << "constexpr auto c = falcon::concat(lit(\"p0\")";
+    for (unsigned i = 1; i < n; ++i) {
+      out << "\n  , lit(\"p" << i << "\")";
+    }
+    out << ");\n";
+    return n;
+  }
+
+  unsigned gen_to_string_literal_u(std::ostream & out, unsigned scale)
+  {
+    header(out);
+    unsigned const n = 1000 * scale;
+    unsigned long long v = 1;
+    for (unsigned i = 0; i < n; ++i) {
+      v = v * 6364136223846793005ull + 1442695040888963407ull;
+      out << "constexpr auto u" << i
+        << " = falcon::to_string_literal_u<" << (v >> (i % 64)) << "ull>();\n";
+    }
+    return n;
+  }
+
+  unsigned gen_substr(std::ostream & out, unsigned scale)
+  {
+    header(out);
+    unsigned const n = 1000 * scale;
+    std::string base;
+    for (unsigned i = 0; i < 512; ++i) {
+      base += char('a' + i % 26);
+    }
+    out << "constexpr auto base = lit(\"" << base << "\");\n";
+    for (unsigned i = 0; i < n; ++i) {
+      out << "constexpr auto s" << i
+        << " = base.substr<" << i % 512 << ", " << (i * 7) % 64 << ">();\n";
+    }
+    return n;
+  }
+
+  construct const constructs[] {
+    {"baseline", "#include only", gen_baseline},
+    {"literals", "lit(\"...\"), 256 sizes", gen_literals},
+    {"concat_chain", "lit + lit + ...", gen_concat_chain},
+    {"concat_variadic", "concat(lit, lit, ...)", gen_concat_variadic},
+    {"to_string_literal_u", "to_string_literal_u<v>()", gen_to_string_literal_u},
+    {"substr", "substr<pos, n>()", gen_substr},
+  };
+
+  struct measure_result
+  {
+    bool ok;
+    double seconds;
+    long peak_rss_kib;
+  };
+
+  measure_result compile(std::string const & source, std::string const & object)
+  {
+    std::string const include1 = "-I" FALCON_BENCH_SOURCE_DIR "/include";
+    std::string const include2 = "-I" FALCON_BENCH_SOURCE_DIR "/module";
+    std::vector<char const *> argv {
+      FALCON_BENCH_CXX, FALCON_BENCH_CXX_STD,
+      include1.c_str(), include2.c_str(),
+      "-c", source.c_str(), "-o", object.c_str(),
+      nullptr
+    };
+
+    auto const t0 = std::chrono::steady_clock::now();
+    pid_t const pid = fork();
+    if (pid == 0) {
+      execvp(argv[0], const_cast<char * const *>(argv.data()));
+      std::perror(argv[0]);
+      _exit(127);
+    }
+    if (pid < 0) {
+      std::perror("fork");
+      return {false, 0, 0};
+    }
+
+    int status = 0;
+    rusage usage{};
+    if (wait4(pid, &status, 0, &usage) < 0) {
+      std::perror("wait4");
+      return {false, 0, 0};
+    }
+    std::chrono::duration<double> const dt
+      = std::chrono::steady_clock::now() - t0;
+
+#ifdef __APPLE__
+    long const rss_kib = long(usage.ru_maxrss / 1024);
+#else
+    long const rss_kib = long(usage.ru_maxrss);
+#endif
+
+    bool const ok = WIFEXITED(status) && WEXITSTATUS(status) == 0;
+    return {ok, dt.count(), rss_kib};
+  }
+}
+
+
+int main(int ac, char ** av)
+{
+  unsigned const scale = ac > 1 ? unsigned(std::max(1, std::atoi(av[1]))) : 1;
+  char const * const filter = ac > 2 ? av[2] : nullptr;
+  int const repeat = 3;
+
+  std::string const dir = FALCON_BENCH_OUTPUT_DIR;
+  if (mkdir(dir.c_str(), 0755) && errno != EEXIST) {
+    std::perror(dir.c_str());
+    return 1;
+  }
+
+  std::printf("compiler: %s %s\n\n", FALCON_BENCH_CXX, FALCON_BENCH_CXX_STD);
+  std::printf("%-20s %-26s %6s %9s %9s %10s\n",
+    "construct", "description", "count", "time (s)", "delta (s)", "peak RSS");
+
+  int ret = 0;
+  double baseline = 0;
+  for (construct const & c : constructs) {
+    bool const is_baseline = (&c == constructs);
+    if (!is_baseline && filter && !std::strstr(c.name, filter)) {
+      continue;
+    }
+
+    std::string const source = dir + "/" + c.name + ".cpp";
+    std::string const object = dir + "/" + c.name + ".o";
+    unsigned count;
+    {
+      std::ofstream out(source);
+      count = c.generate(out, scale);
+      if (!out) {
+        std::perror(source.c_str());
+        return 1;
+      }
+    }
+
+    measure_result best{true, 0, 0};
+    for (int i = 0; i < repeat; ++i) {
+      measure_result const r = compile(source, object);
+      if (!r.ok) {
+        best.ok = false;
+        break;
+      }
+      best.seconds = (i == 0) ? r.seconds : std::min(best.seconds, r.seconds);
+      best.peak_rss_kib = std::max(best.peak_rss_kib, r.peak_rss_kib);
+    }
+
+    if (!best.ok) {
+      std::printf("%-20s %-26s %6u  compilation failed (%s)\n",
+        c.name, c.description, count, source.c_str());
+      ret = 1;
+      continue;
+    }
+
+    if (is_baseline) {
+      baseline = best.seconds;
+    }
+    std::printf("%-20s %-26s %6u %9.3f %9.3f %7ld MiB\n",
+      c.name, c.description, count, best.seconds, best.seconds - baseline,
+      best.peak_rss_kib / 1024);
+  }
+
+  return ret;
+}
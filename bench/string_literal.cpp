@@ -0,0 +1,286 @@
+/* The MIT License (MIT)
+
+Copyright (c) 2016 jonathan poelen
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/**
+* \author    Jonathan Poelen <jonathan.poelen+falcon@gmail.com>
+* \version   1.0
+* \brief     Runtime benchmark of basic_string_literal against std::string_view and libc
+*
+* Usage: string_literal_bench [operation-filter]
+*
+* Build with optimizations (-DCMAKE_BUILD_TYPE=Release), timings of a debug
+* build are meaningless.
+*/
+
+#include "falcon/container/string_literal.hpp"
+#include "falcon/container/string_literal_searcher.hpp"
+#include "falcon/container/string_literal_charset.hpp"
+#include "falcon/container/string_literal_parse.hpp"
+#include "falcon/container/string_literal_case.hpp"
+#include "falcon/string_id.hpp"
+
+#include <string_view>
+#include <charconv>
+#include <string>
+#include <memory>
+#include <chrono>
+#include <functional>
+#include <algorithm>
+#include <atomic>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#if defined(__unix__) || defined(__APPLE__)
+# include <strings.h>
+#endif
+
+
+namespace
+{
+  using namespace falcon::make_string_literal_shortcut;
+  using falcon::string_literal;
+
+#if defined(__GNUC__) || defined(__clang__)
+  /// Forces the compiler to materialize \a x.
+  template<class T>
+  inline void do_not_optimize(T const & x)
+  { asm volatile("" : : "r,m"(x) : "memory"); }
+
+  /// Forces the compiler to assume that all memory has been modified.
+  inline void clobber()
+  { asm volatile("" : : : "memory"); }
+#else
+  void volatile const * volatile sink;
+
+  template<class T>
+  inline void do_not_optimize(T const & x)
+  { sink = &x; }
+
+  inline void clobber()
+  { std::atomic_signal_fence(std::memory_order_seq_cst); }
+#endif
+
+  using bench_clock = std::chrono::steady_clock;
+
+  char const * op_filter = nullptr;
+
+  /// Returns the best time (in nanoseconds) of one call to \a f.
+  template<class F>
+  double measure(F f)
+  {
+    using ns = std::chrono::duration<double, std::nano>;
+    constexpr ns min_run_time = std::chrono::milliseconds(10);
+
+    auto run = [&f](std::size_t iterations) {
+      auto const t0 = bench_clock::now();
+      for (std::size_t i = 0; i < iterations; ++i) {
+        clobber();
+        do_not_optimize(f());
+      }
+      return ns(bench_clock::now() - t0);
+    };
+
+    std::size_t iterations = 1;
+    while (run(iterations) < min_run_time) {
+      iterations *= 2;
+    }
+
+    double best = run(iterations).count();
+    for (int i = 0; i < 4; ++i) {
+      best = std::min(best, run(iterations).count());
+    }
+    return best / double(iterations);
+  }
+
+  template<class F>
+  void bench(char const * op, std::size_t size, char const * impl, F f)
+  {
+    if (op_filter && !std::strstr(op, op_filter)) {
+      return;
+    }
+    double const t = measure(f);
+    std::printf("%-14s %6zu  %-18s %11.2f ns %9.3f GB/s\n",
+      op, size, impl, t, double(size) / t);
+  }
+
+  /// haystacks of \a N characters with a needle (xyz) at one end.
+  template<std::size_t N>
+  struct data_set
+  {
+    string_literal<N> needle_at_end;
+    string_literal<N> needle_at_end2;
+    string_literal<N> needle_at_begin;
+  };
+
+  template<std::size_t N>
+  void bench_size(char fill)
+  {
+    // built at runtime, an initialization in a constant expression
+    // of 64 KiB costs more than the benchmark itself
+    std::unique_ptr<data_set<N>> const ds{new data_set<N>{
+      falcon::make_string_literal<N-3>(fill) + lit("xyz"),
+      falcon::make_string_literal<N-3>(fill) + lit("xyz"),
+      lit("xyz") + falcon::make_string_literal<N-3>(fill),
+    }};
+    auto & hay = ds->needle_at_end;
+    auto & hay2 = ds->needle_at_end2;
+    auto & rhay = ds->needle_at_begin;
+
+    std::string_view const sv = hay.to_string_view();
+    std::string_view const sv2 = hay2.to_string_view();
+    std::string_view const rsv = rhay.to_string_view();
+
+    constexpr auto needle = lit("xyz");
+    constexpr std::string_view sv_needle = "xyz";
+    static auto const searcher = falcon::make_string_literal_searcher(needle);
+    static auto const charset = falcon::make_string_literal_charset(needle);
+
+    std::unique_ptr<char[]> const buf{new char[N]};
+    char * const out = buf.get();
+
+    bench("find", N, "string_literal", [&]{ return hay.find(needle); });
+    bench("find", N, "searcher", [&]{ return hay.find(searcher); });
+    bench("find", N, "string_view", [&]{ return sv.find(sv_needle); });
+    bench("find", N, "strstr", [&]{ return std::strstr(hay.c_str(), "xyz"); });
+
+    bench("rfind", N, "string_literal", [&]{ return rhay.rfind(needle); });
+    bench("rfind", N, "searcher", [&]{ return rhay.rfind(searcher); });
+    bench("rfind", N, "string_view", [&]{ return rsv.rfind(sv_needle); });
+
+    bench("find_first_of", N, "string_literal",
+      [&]{ return hay.find_first_of(needle); });
+    bench("find_first_of", N, "charset",
+      [&]{ return hay.find_first_of(charset); });
+    bench("find_first_of", N, "string_view",
+      [&]{ return sv.find_first_of(sv_needle); });
+    bench("find_first_of", N, "strcspn",
+      [&]{ return std::strcspn(hay.c_str(), "xyz"); });
+
+    bench("compare", N, "string_literal", [&]{ return hay.compare(hay2); });
+    bench("compare", N, "string_view", [&]{ return sv.compare(sv2); });
+    bench("compare", N, "memcmp",
+      [&]{ return std::memcmp(hay.data(), hay2.data(), N); });
+
+    bench("operator==", N, "string_literal", [&]{ return hay == hay2; });
+    bench("operator==", N, "string_view", [&]{ return sv == sv2; });
+    bench("operator==", N, "memcmp",
+      [&]{ return !std::memcmp(hay.data(), hay2.data(), N); });
+
+    using ci_literal = falcon::ci_string_literal<N>;
+    std::unique_ptr<ci_literal> const ci_hay{
+      new ci_literal{falcon::to_ci_string_literal(hay)}};
+    std::unique_ptr<ci_literal> const ci_hay2{
+      new ci_literal{falcon::to_ci_string_literal(falcon::to_upper(hay2))}};
+
+    bench("compare_ci", N, "ci_string_literal",
+      [&]{ return ci_hay->compare(*ci_hay2); });
+#if defined(__unix__) || defined(__APPLE__)
+    bench("compare_ci", N, "strncasecmp",
+      [&]{ return strncasecmp(hay.data(), ci_hay2->data(), N); });
+#endif
+
+    bench("copy", N, "string_literal",
+      [&]{ return hay.copy(out, N); });
+    bench("copy", N, "string_view",
+      [&]{ return sv.copy(out, N); });
+    bench("copy", N, "memcpy",
+      [&]{ return std::memcpy(out, hay.data(), N); });
+
+    bench("to_string", N, "string_literal", [&]{ return hay.to_string(); });
+    bench("to_string", N, "string_view", [&]{ return std::string(sv); });
+    bench("to_string", N, "malloc+memcpy", [&]{
+      std::unique_ptr<char, decltype(&std::free)> p{
+        static_cast<char*>(std::malloc(N + 1)), &std::free};
+      std::memcpy(p.get(), hay.data(), N + 1);
+      return p;
+    });
+
+    bench("std::hash", N, "string_literal",
+      [&]{ return std::hash<string_literal<N>>{}(hay); });
+    bench("std::hash", N, "wymum_hash",
+      [&]{ return falcon::wymum_hash_fn{}(hay.begin(), hay.end()); });
+    bench("std::hash", N, "string_view",
+      [&]{ return std::hash<std::string_view>{}(sv); });
+
+    bench("string_id", N, "string_literal",
+      [&]{ return falcon::string_id(hay); });
+    bench("string_id", N, "string_view",
+      [&]{ return falcon::string_id(sv); });
+  }
+
+  /// decimal numbers of \a ndigits digits
+  void bench_parse(std::size_t ndigits)
+  {
+    constexpr std::size_t count = 64;
+    std::string numbers[count];
+    unsigned long long x = 1;
+    for (std::string & s : numbers) {
+      x = x * 6364136223846793005ull + 1442695040888963407ull;
+      s = std::to_string(x);
+      s.resize(ndigits);
+      s[0] = char('1' + x % 9);
+    }
+
+    std::size_t i = 0;
+    auto next = [&]() -> std::string const & { return numbers[i++ % count]; };
+
+    bench("parse_uint", ndigits, "parse_uint", [&]{
+      return falcon::parse_uint<unsigned long long>(std::string_view(next())).value_or(0);
+    });
+    bench("parse_uint", ndigits, "from_chars", [&]{
+      std::string const & s = next();
+      unsigned long long v = 0;
+      std::from_chars(s.data(), s.data() + s.size(), v);
+      return v;
+    });
+    bench("parse_uint", ndigits, "strtoull", [&]{
+      return std::strtoull(next().c_str(), nullptr, 10);
+    });
+  }
+}
+
+
+int main(int ac, char ** av)
+{
+  if (ac > 1) {
+    op_filter = av[1];
+  }
+
+  // not a constant, the data sets are built at runtime
+  char const fill = ac > 2 ? av[2][0] : 'a';
+
+  std::printf("%-14s %6s  %-18s %14s %14s\n",
+    "operation", "size", "implementation", "time", "throughput");
+  bench_size<8>(fill);
+  bench_size<64>(fill);
+  bench_size<512>(fill);
+  bench_size<4096>(fill);
+  bench_size<65536>(fill);
+
+  bench_parse(4);
+  bench_parse(8);
+  bench_parse(16);
+  bench_parse(19);
+}
@@ -0,0 +1,439 @@
+/* The MIT License (MIT)
+
+Copyright (c) 2016 jonathan poelen
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/**
+* \author    Jonathan Poelen <jonathan.poelen+falcon@gmail.com>
+* \version   1.0
+* \brief     String literal aligned and zero-padded for vector loads
+*
+* \ingroup strings
+*/
+
+#pragma once
+
+#include <falcon/container/string_literal.hpp>
+#include <falcon/container/string_literal_fwd.hpp>
+#include <falcon/container/detail/string_literal_simd.hpp>
+#include <falcon/container/detail/throw_or_abort.hpp>
+#include <falcon/cxx/is_constant_evaluated.hpp>
+#include <falcon/cxx/string_view.hpp>
+
+#include <type_traits>
+
+
+namespace falcon {
+inline namespace container {
+
+namespace detail_
+{
+  [[noreturn]] inline void aligned_string_literal_find_out_of_range()
+  {
+    throw_or_abort<std::out_of_range>(
+      "basic_aligned_string_literal::find: pos > size()");
+  }
+
+  /// Non constexpr kernels of basic_aligned_string_literal, selected when
+  /// the call is not constant-evaluated.
+  template<class Ch, class Tr, std::size_t Align>
+  struct aligned_runtime
+  {
+    static constexpr bool find_enabled = false;
+    static constexpr bool equal_enabled = false;
+
+    // never called
+    static std::size_t find(Ch const *, std::size_t, Ch, std::size_t) noexcept
+    { return std::size_t(-1); }
+
+    static std::size_t rfind(Ch const *, std::size_t, Ch, std::size_t) noexcept
+    { return std::size_t(-1); }
+
+    static bool equal(Ch const *, Ch const *, std::size_t) noexcept
+    { return false; }
+  };
+
+#ifdef FALCON_STRING_LITERAL_SIMD
+  template<class Ch, class Tr, std::size_t Align>
+  struct aligned_runtime_simd
+  : aligned_runtime<Ch, void, Align>
+  {
+    // bytewise equality is the equality of std::char_traits and
+    // a block of the kernels must not go beyond the padding
+    static constexpr bool equal_enabled = Align >= simd::vec::width;
+
+    /// \a n characters, padding included
+    static bool equal(Ch const * a, Ch const * b, std::size_t n) noexcept
+    {
+      return simd::equal_padded(
+        reinterpret_cast<char const *>(a),
+        reinterpret_cast<char const *>(b),
+        n * sizeof(Ch));
+    }
+  };
+
+  template<std::size_t Align>
+  struct aligned_runtime<char, std::char_traits<char>, Align>
+  : aligned_runtime_simd<char, std::char_traits<char>, Align>
+  {
+    static constexpr bool find_enabled = Align >= simd::vec::width;
+
+    static std::size_t find(
+      char const * s, std::size_t n, char c, std::size_t pos) noexcept
+    { return simd::find_char_padded(s, n, c, pos); }
+
+    static std::size_t rfind(
+      char const * s, std::size_t n, char c, std::size_t pos) noexcept
+    { return simd::rfind_char_padded(s, n, c, pos); }
+  };
+
+  template<std::size_t Align>
+  struct aligned_runtime<wchar_t, std::char_traits<wchar_t>, Align>
+  : aligned_runtime_simd<wchar_t, std::char_traits<wchar_t>, Align>
+  {};
+
+  template<std::size_t Align>
+  struct aligned_runtime<char16_t, std::char_traits<char16_t>, Align>
+  : aligned_runtime_simd<char16_t, std::char_traits<char16_t>, Align>
+  {};
+
+  template<std::size_t Align>
+  struct aligned_runtime<char32_t, std::char_traits<char32_t>, Align>
+  : aligned_runtime_simd<char32_t, std::char_traits<char32_t>, Align>
+  {};
+#endif
+}
+
+
+/**
+ * \brief  Copy of a basic_string_literal whose characters are aligned on
+ * \a Align bytes and followed by null characters up to a multiple of
+ * \a Align bytes.
+ *
+ * The vector kernels read whole blocks, without tail loop: the padding is
+ * readable and never part of the string (size() is \a N). They are used for
+ * find(Ch), rfind(Ch) and operator== when \a Align is at least the vector
+ * width of the target (16 bytes with SSE2, 32 with AVX2) and the call is not
+ * constant-evaluated. The other members use the algorithms of
+ * basic_string_literal.
+ *
+ * \code
+ * constexpr auto method = make_aligned_string_literal<32>(lit("OPTIONS"));
+ * static_assert(sizeof(method) == 32, "");
+ * \endcode
+ *
+ * \tparam Ch  Type of character.
+ * \tparam N  Number of characters, not including any null-termination.
+ * \tparam Align  Alignment in bytes, a power of 2.
+ * \tparam Traits  Traits for character type.
+ */
+template<class Ch, std::size_t N, std::size_t Align, class Traits>
+struct basic_aligned_string_literal
+{
+  static_assert(Align && !(Align & (Align - 1)), "Align must be a power of 2");
+  static_assert(Align >= alignof(Ch), "Align < alignof(Ch)");
+
+  using value_type = Ch;
+  using traits_type = Traits;
+
+  using const_pointer = Ch const *;
+  using const_reference = Ch const &;
+  using const_iterator = const_pointer;
+
+  using pointer = Ch const *;
+  using reference = Ch const &;
+  using iterator = pointer;
+
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+
+  static constexpr size_type npos = size_type(-1);
+
+  constexpr explicit
+  basic_aligned_string_literal(
+    basic_string_literal<Ch, N, Traits> const & str) noexcept
+  {
+    for (size_type i = 0; i < N; ++i) {
+      data_[i] = str[i];
+    }
+  }
+
+  /// Alignment of data() in bytes.
+  static constexpr size_type alignment() noexcept
+  { return Align; }
+
+  /// Number of readable characters from data(), null characters included.
+  static constexpr size_type padded_size() noexcept
+  { return padded_size_; }
+
+  constexpr size_type size() const noexcept { return N; }
+  constexpr size_type length() const noexcept { return N; }
+
+  /// Returns the size() of the largest possible %string, as basic_string_literal::max_size().
+  constexpr size_type max_size() const noexcept
+  {
+    return (npos - sizeof(size_type) - sizeof(void*))
+      / sizeof(value_type) / 4;
+  }
+
+  constexpr bool empty() const noexcept { return !N; }
+
+  constexpr const_reference operator[](size_type pos) const noexcept
+  { return data_[pos]; }
+  constexpr const_reference front() const noexcept { return data_[0]; }
+  constexpr const_reference back() const noexcept { return data_[N-1]; }
+
+  constexpr const_iterator begin() const noexcept { return data_; }
+  constexpr const_iterator end() const noexcept { return data_ + N; }
+
+  constexpr const_iterator cbegin() const noexcept { return data_; }
+  constexpr const_iterator cend() const noexcept { return data_ + N; }
+
+  constexpr const_pointer data() const noexcept { return data_; }
+  constexpr const_pointer c_str() const noexcept { return data_; }
+
+  /// Copy without alignment.
+  constexpr basic_string_literal<Ch, N, Traits> str() const noexcept
+  { return detail_::core_access::mk_lit<N, Traits>(data_, N); }
+
+
+  template<std::size_t M>
+  constexpr int
+  compare(basic_string_literal<Ch, M, Traits> const & str) const noexcept
+  { return algorithms_type_::compare_({data_, N}, {str.data(), M}); }
+
+  template<std::size_t M, std::size_t A>
+  constexpr int
+  compare(basic_aligned_string_literal<Ch, M, A, Traits> const & str) const noexcept
+  { return algorithms_type_::compare_({data_, N}, {str.data(), M}); }
+
+  constexpr int
+  compare(Ch const * s) const noexcept
+  { return algorithms_type_::compare_({data_, N}, {s}); }
+
+  /// Same characters, the padding of two objects of the same type is equal.
+  constexpr bool
+  equal(basic_aligned_string_literal const & other) const noexcept
+  {
+#ifdef FALCON_IS_CONSTANT_EVALUATED
+    if (runtime_::equal_enabled && !FALCON_IS_CONSTANT_EVALUATED()) {
+      return runtime_::equal(data_, other.data_, padded_size_);
+    }
+#endif
+    return 0 == compare(other);
+  }
+
+
+  /// \throw std::out_of_range  \a pos > size()
+  constexpr size_type
+  find(Ch c, size_type pos = 0) const
+  {
+    if (pos > N) {
+      detail_::aligned_string_literal_find_out_of_range();
+    }
+#ifdef FALCON_IS_CONSTANT_EVALUATED
+    if (runtime_::find_enabled && !FALCON_IS_CONSTANT_EVALUATED()) {
+      return runtime_::find(data_, N, c, pos);
+    }
+#endif
+    return algorithms_().find(c, pos);
+  }
+
+  template<std::size_t M>
+  constexpr size_type
+  find(basic_string_literal<Ch, M, Traits> const & str, size_type pos = 0) const noexcept
+  { return algorithms_().find_({str.data(), M}, pos); }
+
+  template<std::size_t M>
+  constexpr size_type
+  find(
+    basic_string_literal_searcher<Ch, M, Traits> const & searcher
+  , size_type pos = 0) const noexcept
+  { return searcher.find_in(data_, N, pos); }
+
+  constexpr size_type
+  find(Ch const * s, size_type pos = 0) const noexcept
+  { return algorithms_().find_({s}, pos); }
+
+
+  constexpr size_type
+  rfind(Ch c, size_type pos = npos) const noexcept
+  {
+#ifdef FALCON_IS_CONSTANT_EVALUATED
+    if (runtime_::find_enabled && !FALCON_IS_CONSTANT_EVALUATED()) {
+      return runtime_::rfind(data_, N, c, pos);
+    }
+#endif
+    return algorithms_().rfind(c, pos);
+  }
+
+  template<std::size_t M>
+  constexpr size_type
+  rfind(basic_string_literal<Ch, M, Traits> const & str, size_type pos = npos) const noexcept
+  { return algorithms_().rfind_({str.data(), M}, pos); }
+
+  constexpr size_type
+  rfind(Ch const * s, size_type pos = npos) const noexcept
+  { return algorithms_().rfind_({s}, pos); }
+
+
+  template<std::size_t M>
+  constexpr size_type
+  find_first_of(
+    basic_string_literal_charset<Ch, M, Traits> const & charset
+  , size_type pos = 0) const noexcept
+  { return charset.find_first_of_in(data_, N, pos); }
+
+  template<std::size_t M>
+  constexpr size_type
+  find_last_of(
+    basic_string_literal_charset<Ch, M, Traits> const & charset
+  , size_type pos = npos) const noexcept
+  { return charset.find_last_of_in(data_, N, pos); }
+
+
+  template<class Allocator = std::allocator<Ch>>
+  std::basic_string<Ch, Traits, Allocator>
+  to_string(Allocator const & a = Allocator()) const
+  { return {data_, N, a}; }
+
+#ifdef FALCON_STD_STRING_VIEW
+  constexpr FALCON_STD_STRING_VIEW<Ch, Traits>
+  to_string_view() const
+  { return {data_, N}; }
+
+  constexpr operator FALCON_STD_STRING_VIEW<Ch, Traits> () const
+  { return {data_, N}; }
+#endif
+
+private:
+  using algorithms_type_ = detail_::string_literal_algorithms<Ch, Traits>;
+  using runtime_ = detail_::aligned_runtime<Ch, Traits, Align>;
+
+  static constexpr size_type padded_size_
+    = ((N + 1) * sizeof(Ch) + Align - 1) / Align * Align / sizeof(Ch);
+
+  constexpr algorithms_type_ algorithms_() const noexcept
+  { return {data_, N}; }
+
+  alignas(Align) Ch data_[padded_size_] {};
+};
+
+template<class Ch, std::size_t N, std::size_t Align, class Traits>
+constexpr std::size_t
+basic_aligned_string_literal<Ch, N, Align, Traits>::padded_size_;
+
+template<std::size_t n, std::size_t Align = 32>
+using aligned_string_literal = basic_aligned_string_literal<char, n, Align>;
+template<std::size_t n, std::size_t Align = 32>
+using aligned_wstring_literal = basic_aligned_string_literal<wchar_t, n, Align>;
+template<std::size_t n, std::size_t Align = 32>
+using aligned_u16string_literal = basic_aligned_string_literal<char16_t, n, Align>;
+template<std::size_t n, std::size_t Align = 32>
+using aligned_u32string_literal = basic_aligned_string_literal<char32_t, n, Align>;
+
+
+/// Creates a basic_aligned_string_literal object, deducing the target type from the types of arguments.
+template<std::size_t Align, class Ch, std::size_t N, class Tr>
+constexpr basic_aligned_string_literal<Ch, N, Align, Tr>
+make_aligned_string_literal(basic_string_literal<Ch, N, Tr> const & str) noexcept
+{ return basic_aligned_string_literal<Ch, N, Align, Tr>{str}; }
+
+/// Creates a basic_aligned_string_literal object, deducing the target type from the types of arguments.
+template<std::size_t Align, class Ch, class Tr = std::char_traits<Ch>, std::size_t N>
+constexpr basic_aligned_string_literal<Ch, N-1, Align, Tr>
+make_aligned_string_literal(Ch const (&arr)[N]) noexcept
+{
+  return basic_aligned_string_literal<Ch, N-1, Align, Tr>{
+    make_string_literal<Ch, Tr>(arr)};
+}
+
+
+template<class Ch, class Tr, std::size_t N, std::size_t Align>
+std::basic_ostream<Ch, Tr> &
+operator<<(
+  std::basic_ostream<Ch, Tr> & out,
+  basic_aligned_string_literal<Ch, N, Align, Tr> const & str)
+{ return iostreams::ostream_insert(out, str.data(), str.size()); }
+
+
+// string comparison
+//@{
+template<class Ch, class Tr, std::size_t n, std::size_t A>
+constexpr bool
+operator==(
+  basic_aligned_string_literal<Ch, n, A, Tr> const & x,
+  basic_aligned_string_literal<Ch, n, A, Tr> const & y) noexcept
+{ return x.equal(y); }
+
+template<class Ch, class Tr, std::size_t n1, std::size_t n2, std::size_t A1, std::size_t A2>
+constexpr bool
+operator==(
+  basic_aligned_string_literal<Ch, n1, A1, Tr> const & x,
+  basic_aligned_string_literal<Ch, n2, A2, Tr> const & y) noexcept
+{ return n1 == n2 && x.compare(y) == 0; }
+
+template<class Ch, class Tr, std::size_t n1, std::size_t n2, std::size_t A>
+constexpr bool
+operator==(
+  basic_aligned_string_literal<Ch, n1, A, Tr> const & x,
+  basic_string_literal<Ch, n2, Tr> const & y) noexcept
+{ return n1 == n2 && x.compare(y) == 0; }
+
+template<class Ch, class Tr, std::size_t n1, std::size_t n2, std::size_t A>
+constexpr bool
+operator==(
+  basic_string_literal<Ch, n1, Tr> const & x,
+  basic_aligned_string_literal<Ch, n2, A, Tr> const & y) noexcept
+{ return n1 == n2 && y.compare(x) == 0; }
+
+template<class Ch, class Tr, std::size_t n1, std::size_t n2, std::size_t A1, std::size_t A2>
+constexpr bool
+operator!=(
+  basic_aligned_string_literal<Ch, n1, A1, Tr> const & x,
+  basic_aligned_string_literal<Ch, n2, A2, Tr> const & y) noexcept
+{ return !(x == y); }
+
+template<class Ch, class Tr, std::size_t n1, std::size_t n2, std::size_t A>
+constexpr bool
+operator!=(
+  basic_aligned_string_literal<Ch, n1, A, Tr> const & x,
+  basic_string_literal<Ch, n2, Tr> const & y) noexcept
+{ return !(x == y); }
+
+template<class Ch, class Tr, std::size_t n1, std::size_t n2, std::size_t A>
+constexpr bool
+operator!=(
+  basic_string_literal<Ch, n1, Tr> const & x,
+  basic_aligned_string_literal<Ch, n2, A, Tr> const & y) noexcept
+{ return !(x == y); }
+//@}
+
+} // container
+}
+
+namespace std
+{
+  template<class Ch, size_t N, size_t Align, class Tr>
+  struct hash<::falcon::container::basic_aligned_string_literal<Ch, N, Align, Tr>>
+  : ::falcon::fnv1a_hash<::falcon::container::basic_aligned_string_literal<Ch, N, Align, Tr>>
+  {};
+}
@@ -0,0 +1,714 @@
+/* The MIT License (MIT)
+
+Copyright (c) 2016 jonathan poelen
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/**
+* \author    Jonathan Poelen <jonathan.poelen+falcon@gmail.com>
+* \version   1.0
+* \brief     Runtime vector kernels used by basic_string_literal
+*
+* Only used when the call is not constant-evaluated. Every kernel returns
+* exactly what the scalar constexpr algorithm of basic_string_literal returns.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__AVX2__)
+# include <immintrin.h>
+# define FALCON_STRING_LITERAL_SIMD 1
+# define FALCON_STRING_LITERAL_SIMD_SHUFFLE 1
+#elif defined(__SSE2__) || defined(_M_X64)
+# include <emmintrin.h>
+# define FALCON_STRING_LITERAL_SIMD 1
+# if defined(__SSSE3__)
+#  include <tmmintrin.h>
+#  define FALCON_STRING_LITERAL_SIMD_SHUFFLE 1
+# endif
+#endif
+
+#if defined(_MSC_VER) && !defined(__clang__)
+# include <intrin.h>
+#endif
+
+
+namespace falcon {
+inline namespace container {
+namespace detail_ {
+
+/// 'A'-'Z' to 'a'-'z', the other characters unchanged.
+template<class Ch>
+constexpr Ch ascii_to_lower(Ch c) noexcept
+{ return (c >= Ch('A') && c <= Ch('Z')) ? Ch(c - Ch('A') + Ch('a')) : c; }
+
+/// 'a'-'z' to 'A'-'Z', the other characters unchanged.
+template<class Ch>
+constexpr Ch ascii_to_upper(Ch c) noexcept
+{ return (c >= Ch('a') && c <= Ch('z')) ? Ch(c - Ch('a') + Ch('A')) : c; }
+
+namespace simd {
+
+constexpr std::size_t npos = std::size_t(-1);
+
+/// Index of the lowest set bit. \a x must not be 0.
+inline unsigned lowest_bit(std::uint32_t x) noexcept
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+  unsigned long i;
+  _BitScanForward(&i, x);
+  return unsigned(i);
+#else
+  return unsigned(__builtin_ctz(x));
+#endif
+}
+
+/// Index of the highest set bit. \a x must not be 0.
+inline unsigned highest_bit(std::uint32_t x) noexcept
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+  unsigned long i;
+  _BitScanReverse(&i, x);
+  return unsigned(i);
+#else
+  return 31u - unsigned(__builtin_clz(x));
+#endif
+}
+
+/// Index of the lowest set bit. \a x must not be 0.
+inline unsigned lowest_bit64(std::uint64_t x) noexcept
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+  unsigned long i;
+  _BitScanForward64(&i, x);
+  return unsigned(i);
+#else
+  return unsigned(__builtin_ctzll(x));
+#endif
+}
+
+/// Word of sizeof(T) bytes at \a p.
+template<class T>
+inline T load_word(char const * p) noexcept
+{
+  T x;
+  std::memcpy(&x, p, sizeof(T));
+  return x;
+}
+
+#ifdef FALCON_STRING_LITERAL_SIMD
+# if defined(__AVX2__)
+struct vec
+{
+  using type = __m256i;
+  static constexpr std::size_t width = 32;
+
+  static type set1(char c) noexcept
+  { return _mm256_set1_epi8(c); }
+
+  static type load(char const * p) noexcept
+  { return _mm256_loadu_si256(reinterpret_cast<__m256i const *>(p)); }
+
+  /// \pre \a p is aligned on width
+  static type load_aligned(char const * p) noexcept
+  { return _mm256_load_si256(reinterpret_cast<__m256i const *>(p)); }
+
+  /// bit i is set when a[i] == x[i]
+  static std::uint32_t eq(type a, type x) noexcept
+  { return std::uint32_t(_mm256_movemask_epi8(_mm256_cmpeq_epi8(a, x))); }
+
+  /// 'A'-'Z' to 'a'-'z', the other bytes unchanged
+  static type to_lower(type a) noexcept
+  {
+    // 'A'-'Z' moved to -128..-103
+    auto const shifted = _mm256_add_epi8(a, _mm256_set1_epi8(0x80 - 'A'));
+    auto const upper = _mm256_cmpgt_epi8(
+      _mm256_set1_epi8(char(-128 + 26)), shifted);
+    return _mm256_or_si256(a, _mm256_and_si256(upper, _mm256_set1_epi8(0x20)));
+  }
+
+  /// bit i is set when a[i] == x and b[i] == y
+  static std::uint32_t eq2(type a, type x, type b, type y) noexcept
+  {
+    return std::uint32_t(_mm256_movemask_epi8(_mm256_and_si256(
+      _mm256_cmpeq_epi8(a, x), _mm256_cmpeq_epi8(b, y))));
+  }
+
+  static type table(std::uint8_t const (&t)[16]) noexcept
+  {
+    return _mm256_broadcastsi128_si256(
+      _mm_loadu_si128(reinterpret_cast<__m128i const *>(t)));
+  }
+
+  /// bit i is set when a[i] is in the set described by the nibble tables
+  static std::uint32_t in_set(type a, type tlo, type thi) noexcept
+  {
+    auto const lo_nibbles = _mm256_and_si256(a, _mm256_set1_epi8(0x0f));
+    auto const hi_nibbles = _mm256_and_si256(
+      _mm256_srli_epi16(a, 4), _mm256_set1_epi8(0x0f));
+    auto const bits_lo = _mm256_setr_epi8(
+      1, 2, 4, 8, 16, 32, 64, -128, 0, 0, 0, 0, 0, 0, 0, 0,
+      1, 2, 4, 8, 16, 32, 64, -128, 0, 0, 0, 0, 0, 0, 0, 0);
+    auto const bits_hi = _mm256_setr_epi8(
+      0, 0, 0, 0, 0, 0, 0, 0, 1, 2, 4, 8, 16, 32, 64, -128,
+      0, 0, 0, 0, 0, 0, 0, 0, 1, 2, 4, 8, 16, 32, 64, -128);
+    auto const r = _mm256_or_si256(
+      _mm256_and_si256(
+        _mm256_shuffle_epi8(tlo, lo_nibbles),
+        _mm256_shuffle_epi8(bits_lo, hi_nibbles)),
+      _mm256_and_si256(
+        _mm256_shuffle_epi8(thi, lo_nibbles),
+        _mm256_shuffle_epi8(bits_hi, hi_nibbles)));
+    return ~std::uint32_t(_mm256_movemask_epi8(
+      _mm256_cmpeq_epi8(r, _mm256_setzero_si256())));
+  }
+};
+# else
+struct vec
+{
+  using type = __m128i;
+  static constexpr std::size_t width = 16;
+
+  static type set1(char c) noexcept
+  { return _mm_set1_epi8(c); }
+
+  static type load(char const * p) noexcept
+  { return _mm_loadu_si128(reinterpret_cast<__m128i const *>(p)); }
+
+  /// \pre \a p is aligned on width
+  static type load_aligned(char const * p) noexcept
+  { return _mm_load_si128(reinterpret_cast<__m128i const *>(p)); }
+
+  /// bit i is set when a[i] == x[i]
+  static std::uint32_t eq(type a, type x) noexcept
+  { return std::uint32_t(_mm_movemask_epi8(_mm_cmpeq_epi8(a, x))); }
+
+  /// 'A'-'Z' to 'a'-'z', the other bytes unchanged
+  static type to_lower(type a) noexcept
+  {
+    // 'A'-'Z' moved to -128..-103
+    auto const shifted = _mm_add_epi8(a, _mm_set1_epi8(0x80 - 'A'));
+    auto const upper = _mm_cmplt_epi8(shifted, _mm_set1_epi8(char(-128 + 26)));
+    return _mm_or_si128(a, _mm_and_si128(upper, _mm_set1_epi8(0x20)));
+  }
+
+  /// bit i is set when a[i] == x and b[i] == y
+  static std::uint32_t eq2(type a, type x, type b, type y) noexcept
+  {
+    return std::uint32_t(_mm_movemask_epi8(_mm_and_si128(
+      _mm_cmpeq_epi8(a, x), _mm_cmpeq_epi8(b, y))));
+  }
+
+#  ifdef FALCON_STRING_LITERAL_SIMD_SHUFFLE
+  static type table(std::uint8_t const (&t)[16]) noexcept
+  { return _mm_loadu_si128(reinterpret_cast<__m128i const *>(t)); }
+
+  /// bit i is set when a[i] is in the set described by the nibble tables
+  static std::uint32_t in_set(type a, type tlo, type thi) noexcept
+  {
+    auto const lo_nibbles = _mm_and_si128(a, _mm_set1_epi8(0x0f));
+    auto const hi_nibbles = _mm_and_si128(
+      _mm_srli_epi16(a, 4), _mm_set1_epi8(0x0f));
+    auto const bits_lo = _mm_setr_epi8(
+      1, 2, 4, 8, 16, 32, 64, -128, 0, 0, 0, 0, 0, 0, 0, 0);
+    auto const bits_hi = _mm_setr_epi8(
+      0, 0, 0, 0, 0, 0, 0, 0, 1, 2, 4, 8, 16, 32, 64, -128);
+    auto const r = _mm_or_si128(
+      _mm_and_si128(
+        _mm_shuffle_epi8(tlo, lo_nibbles),
+        _mm_shuffle_epi8(bits_lo, hi_nibbles)),
+      _mm_and_si128(
+        _mm_shuffle_epi8(thi, lo_nibbles),
+        _mm_shuffle_epi8(bits_hi, hi_nibbles)));
+    return 0xffffu & ~std::uint32_t(_mm_movemask_epi8(
+      _mm_cmpeq_epi8(r, _mm_setzero_si128())));
+  }
+#  endif
+};
+# endif
+
+/**
+ * First position >= \a pos of \a w (of size \a m) in \a s (of size \a n).
+ * Candidates are filtered on the first and the last character of \a w,
+ * then checked with memcmp.
+ * \pre 0 < m
+ */
+inline std::size_t find(
+  char const * s, std::size_t n,
+  char const * w, std::size_t m, std::size_t pos) noexcept
+{
+  if (m > n) {
+    return npos;
+  }
+
+  std::size_t const last = n - m;
+  auto const vfirst = vec::set1(w[0]);
+  auto const vlast = vec::set1(w[m-1]);
+
+  for (; pos <= last && last - pos >= vec::width - 1; pos += vec::width) {
+    std::uint32_t mask = vec::eq2(
+      vec::load(s + pos), vfirst,
+      vec::load(s + pos + m - 1), vlast);
+    while (mask) {
+      std::size_t const i = pos + lowest_bit(mask);
+      if (m <= 2 || 0 == std::memcmp(s + i + 1, w + 1, m - 2)) {
+        return i;
+      }
+      mask &= mask - 1u;
+    }
+  }
+
+  for (; pos <= last; ++pos) {
+    if (s[pos] == w[0] && 0 == std::memcmp(s + pos + 1, w + 1, m - 1)) {
+      return pos;
+    }
+  }
+
+  return npos;
+}
+
+/**
+ * Last position <= \a pos of \a w (of size \a m) in \a s (of size \a n).
+ * \pre 0 < m
+ */
+inline std::size_t rfind(
+  char const * s, std::size_t n,
+  char const * w, std::size_t m, std::size_t pos) noexcept
+{
+  if (m > n) {
+    return npos;
+  }
+
+  if (pos > n - m) {
+    pos = n - m;
+  }
+
+  auto const vfirst = vec::set1(w[0]);
+  auto const vlast = vec::set1(w[m-1]);
+
+  while (pos >= vec::width - 1) {
+    std::size_t const block = pos - (vec::width - 1);
+    std::uint32_t mask = vec::eq2(
+      vec::load(s + block), vfirst,
+      vec::load(s + block + m - 1), vlast);
+    while (mask) {
+      unsigned const bit = highest_bit(mask);
+      std::size_t const i = block + bit;
+      if (m <= 2 || 0 == std::memcmp(s + i + 1, w + 1, m - 2)) {
+        return i;
+      }
+      mask &= ~(std::uint32_t(1) << bit);
+    }
+    if (block == 0) {
+      return npos;
+    }
+    pos = block - 1;
+  }
+
+  do {
+    if (0 == std::memcmp(s + pos, w, m)) {
+      return pos;
+    }
+  }
+  while (pos-- > 0);
+
+  return npos;
+}
+
+/**
+ * First position >= \a pos of \a c in \a s (of size \a n), without tail
+ * loop: the blocks are read with aligned loads up to the end of the last
+ * one and the matches beyond \a n are ignored.
+ * \pre \a s is aligned on vec::width and readable up to \a n rounded up
+ * to a multiple of vec::width
+ */
+inline std::size_t find_char_padded(
+  char const * s, std::size_t n, char c, std::size_t pos) noexcept
+{
+  if (pos >= n) {
+    return npos;
+  }
+
+  auto const vc = vec::set1(c);
+  std::size_t block = pos - pos % vec::width;
+  std::uint32_t mask = vec::eq(vec::load_aligned(s + block), vc);
+  mask &= ~std::uint32_t(0) << (pos - block);
+  for (;;) {
+    if (mask) {
+      std::size_t const i = block + lowest_bit(mask);
+      return i < n ? i : npos;
+    }
+    block += vec::width;
+    if (block >= n) {
+      return npos;
+    }
+    mask = vec::eq(vec::load_aligned(s + block), vc);
+  }
+}
+
+/**
+ * Last position <= \a pos of \a c in \a s (of size \a n).
+ * \pre same as find_char_padded()
+ */
+inline std::size_t rfind_char_padded(
+  char const * s, std::size_t n, char c, std::size_t pos) noexcept
+{
+  if (!n) {
+    return npos;
+  }
+
+  if (pos > n - 1) {
+    pos = n - 1;
+  }
+
+  auto const vc = vec::set1(c);
+  std::size_t block = pos - pos % vec::width;
+  std::uint32_t mask = vec::eq(vec::load_aligned(s + block), vc);
+  // keeps the bits <= pos - block
+  mask &= ~std::uint32_t(0) >> (31u - (pos - block));
+  for (;;) {
+    if (mask) {
+      return block + highest_bit(mask);
+    }
+    if (block == 0) {
+      return npos;
+    }
+    block -= vec::width;
+    mask = vec::eq(vec::load_aligned(s + block), vc);
+  }
+}
+
+/**
+ * Bytewise equality of \a a and \a b.
+ * \pre \a a and \a b are aligned on vec::width and \a nbytes is
+ * a multiple of vec::width
+ */
+inline bool equal_padded(
+  char const * a, char const * b, std::size_t nbytes) noexcept
+{
+  std::uint32_t const all = std::uint32_t((std::uint64_t(1) << vec::width) - 1u);
+  for (std::size_t i = 0; i < nbytes; i += vec::width) {
+    if (vec::eq(vec::load_aligned(a + i), vec::load_aligned(b + i)) != all) {
+      return false;
+    }
+  }
+  return true;
+}
+
+# ifdef FALCON_STRING_LITERAL_SIMD_SHUFFLE
+/**
+ * Nibble tables of a set of bytes: bit h of tlo[l] (resp. thi[l]) is set
+ * when the byte (h << 4 | l) (resp. ((h + 8) << 4 | l)) is in the set.
+ */
+struct nibble_tables
+{
+  std::uint8_t const (&tlo)[16];
+  std::uint8_t const (&thi)[16];
+
+  bool contains(char c) const noexcept
+  {
+    unsigned const u = static_cast<unsigned char>(c);
+    unsigned const h = u >> 4;
+    return (h < 8 ? tlo[u & 0xfu] >> h : thi[u & 0xfu] >> (h - 8)) & 1u;
+  }
+};
+
+/**
+ * First position >= \a pos of \a s (of size \a n) whose character is
+ * (\a negate = false) or is not (\a negate = true) in \a t.
+ */
+inline std::size_t find_first_of(
+  char const * s, std::size_t n, std::size_t pos,
+  nibble_tables t, bool negate) noexcept
+{
+  auto const vlo = vec::table(t.tlo);
+  auto const vhi = vec::table(t.thi);
+  std::uint32_t const inv = negate
+    ? std::uint32_t((std::uint64_t(1) << vec::width) - 1u)
+    : 0u;
+
+  for (; pos < n && n - pos >= vec::width; pos += vec::width) {
+    std::uint32_t const mask = vec::in_set(vec::load(s + pos), vlo, vhi) ^ inv;
+    if (mask) {
+      return pos + lowest_bit(mask);
+    }
+  }
+
+  for (; pos < n; ++pos) {
+    if (t.contains(s[pos]) != negate) {
+      return pos;
+    }
+  }
+
+  return npos;
+}
+
+/**
+ * Last position <= \a pos of \a s (of size \a n) whose character is
+ * (\a negate = false) or is not (\a negate = true) in \a t.
+ */
+inline std::size_t find_last_of(
+  char const * s, std::size_t n, std::size_t pos,
+  nibble_tables t, bool negate) noexcept
+{
+  if (!n) {
+    return npos;
+  }
+
+  if (pos > n - 1) {
+    pos = n - 1;
+  }
+
+  auto const vlo = vec::table(t.tlo);
+  auto const vhi = vec::table(t.thi);
+  std::uint32_t const inv = negate
+    ? std::uint32_t((std::uint64_t(1) << vec::width) - 1u)
+    : 0u;
+
+  while (pos >= vec::width - 1) {
+    std::size_t const block = pos - (vec::width - 1);
+    std::uint32_t const mask
+      = vec::in_set(vec::load(s + block), vlo, vhi) ^ inv;
+    if (mask) {
+      return block + highest_bit(mask);
+    }
+    if (block == 0) {
+      return npos;
+    }
+    pos = block - 1;
+  }
+
+  do {
+    if (t.contains(s[pos]) != negate) {
+      return pos;
+    }
+  }
+  while (pos-- > 0);
+
+  return npos;
+}
+# endif
+#endif
+
+/**
+ * Bytewise equality of \a a and \a b of \a n bytes, read by vectors or
+ * by words. The last block overlaps the previous one instead of a tail loop.
+ */
+inline bool equal_bytes(char const * a, char const * b, std::size_t n) noexcept
+{
+  if (n >= 8) {
+#ifdef FALCON_STRING_LITERAL_SIMD
+    if (n >= vec::width) {
+      std::uint32_t const all
+        = std::uint32_t((std::uint64_t(1) << vec::width) - 1u);
+      for (std::size_t i = 0; i + vec::width < n; i += vec::width) {
+        if (vec::eq(vec::load(a + i), vec::load(b + i)) != all) {
+          return false;
+        }
+      }
+      return vec::eq(
+        vec::load(a + n - vec::width), vec::load(b + n - vec::width)) == all;
+    }
+#endif
+    for (std::size_t i = 0; i + 8 < n; i += 8) {
+      if (load_word<std::uint64_t>(a + i) != load_word<std::uint64_t>(b + i)) {
+        return false;
+      }
+    }
+    return load_word<std::uint64_t>(a + n - 8)
+        == load_word<std::uint64_t>(b + n - 8);
+  }
+  if (n >= 4) {
+    return 0 == ((load_word<std::uint32_t>(a) ^ load_word<std::uint32_t>(b))
+               | (load_word<std::uint32_t>(a + n - 4)
+                  ^ load_word<std::uint32_t>(b + n - 4)));
+  }
+  if (n >= 2) {
+    return load_word<std::uint16_t>(a) == load_word<std::uint16_t>(b)
+        && a[n - 1] == b[n - 1];
+  }
+  return n == 0 || a[0] == b[0];
+}
+
+/**
+ * Index of the first different byte of \a a and \a b of \a n bytes,
+ * \a n when they are equal.
+ */
+inline std::size_t mismatch_bytes(
+  char const * a, char const * b, std::size_t n) noexcept
+{
+  std::size_t i = 0;
+
+#ifdef FALCON_STRING_LITERAL_SIMD
+  std::uint32_t const all
+    = std::uint32_t((std::uint64_t(1) << vec::width) - 1u);
+  for (; n - i >= vec::width; i += vec::width) {
+    std::uint32_t const ne
+      = ~vec::eq(vec::load(a + i), vec::load(b + i)) & all;
+    if (ne) {
+      return i + lowest_bit(ne);
+    }
+  }
+#endif
+
+  // the first byte is the low byte of a word only on little endian
+#if (defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__) \
+  || defined(_MSC_VER)
+  if (n >= 8) {
+    for (; n - i >= 8; i += 8) {
+      std::uint64_t const x
+        = load_word<std::uint64_t>(a + i) ^ load_word<std::uint64_t>(b + i);
+      if (x) {
+        return i + lowest_bit64(x) / 8;
+      }
+    }
+    if (i < n) {
+      // the bytes before i are equal
+      std::uint64_t const x = load_word<std::uint64_t>(a + n - 8)
+                            ^ load_word<std::uint64_t>(b + n - 8);
+      return x ? n - 8 + lowest_bit64(x) / 8 : n;
+    }
+    return n;
+  }
+#endif
+
+  for (; i < n; ++i) {
+    if (a[i] != b[i]) {
+      return i;
+    }
+  }
+  return n;
+}
+
+/// Comparison of \a n bytes as unsigned char, like memcmp,
+/// normalized to -1, 0 or 1.
+inline int compare_bytes(char const * a, char const * b, std::size_t n) noexcept
+{
+  std::size_t const i = mismatch_bytes(a, b, n);
+  return i == n ? 0
+    : static_cast<unsigned char>(a[i]) < static_cast<unsigned char>(b[i])
+    ? -1 : 1;
+}
+
+/// Bytes of \a w with 'A'-'Z' converted to 'a'-'z'.
+inline std::uint64_t swar_to_lower(std::uint64_t w) noexcept
+{
+  constexpr std::uint64_t ones = 0x0101010101010101u;
+  std::uint64_t const heptets = w & (0x7F * ones);
+  // high bit of each byte set when the byte is >= 'A', resp. > 'Z'
+  std::uint64_t const ge_a = heptets + (0x80 - 'A') * ones;
+  std::uint64_t const gt_z = heptets + (0x7F - 'Z') * ones;
+  std::uint64_t const upper = ~w & (ge_a ^ gt_z) & (0x80 * ones);
+  return w | (upper >> 2);
+}
+
+/**
+ * Index of the first different character of \a a and \a b of \a n bytes
+ * ignoring the ASCII case, \a n when they are equal.
+ */
+inline std::size_t mismatch_ci(
+  char const * a, char const * b, std::size_t n) noexcept
+{
+  std::size_t i = 0;
+
+#ifdef FALCON_STRING_LITERAL_SIMD
+  std::uint32_t const all
+    = std::uint32_t((std::uint64_t(1) << vec::width) - 1u);
+  for (; n - i >= vec::width; i += vec::width) {
+    std::uint32_t const ne = ~vec::eq(
+      vec::to_lower(vec::load(a + i)), vec::to_lower(vec::load(b + i))) & all;
+    if (ne) {
+      return i + lowest_bit(ne);
+    }
+  }
+  if (i && i < n) {
+    // the last block overlaps the previous one whose bytes are equal
+    std::size_t const last = n - vec::width;
+    std::uint32_t const ne = ~vec::eq(
+      vec::to_lower(vec::load(a + last)),
+      vec::to_lower(vec::load(b + last))) & all;
+    return ne ? last + lowest_bit(ne) : n;
+  }
+#endif
+
+  // the first byte is the low byte of a word only on little endian
+#if (defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__) \
+  || defined(_MSC_VER)
+  if (n - i >= 8) {
+    for (; n - i >= 8; i += 8) {
+      std::uint64_t const x = swar_to_lower(load_word<std::uint64_t>(a + i))
+                            ^ swar_to_lower(load_word<std::uint64_t>(b + i));
+      if (x) {
+        return i + lowest_bit64(x) / 8;
+      }
+    }
+    if (i < n) {
+      // the bytes before i are equal
+      std::uint64_t const x
+        = swar_to_lower(load_word<std::uint64_t>(a + n - 8))
+        ^ swar_to_lower(load_word<std::uint64_t>(b + n - 8));
+      return x ? n - 8 + lowest_bit64(x) / 8 : n;
+    }
+    return n;
+  }
+#endif
+
+  for (; i < n; ++i) {
+    if (ascii_to_lower(a[i]) != ascii_to_lower(b[i])) {
+      return i;
+    }
+  }
+  return n;
+}
+
+/**
+ * First position >= \a pos of \a lc or of its uppercase in \a s
+ * (of size \a n).
+ * \pre \a lc is 'a'-'z'
+ */
+inline std::size_t find_char_ci(
+  char const * s, std::size_t n, char lc, std::size_t pos) noexcept
+{
+#ifdef FALCON_STRING_LITERAL_SIMD
+  auto const vc = vec::set1(lc);
+  for (; pos < n && n - pos >= vec::width; pos += vec::width) {
+    std::uint32_t const mask = vec::eq(vec::to_lower(vec::load(s + pos)), vc);
+    if (mask) {
+      return pos + lowest_bit(mask);
+    }
+  }
+#endif
+
+  for (; pos < n; ++pos) {
+    if (ascii_to_lower(s[pos]) == lc) {
+      return pos;
+    }
+  }
+  return npos;
+}
+
+} // simd
+} // detail_
+} // container
+}
@@ -0,0 +1,60 @@
+/* The MIT License (MIT)
+
+Copyright (c) 2016 jonathan poelen
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/**
+* \author    Jonathan Poelen <jonathan.poelen+falcon@gmail.com>
+* \version   1.0
+* \brief     Error reporting of the constexpr constructors and functions
+*/
+
+#pragma once
+
+#include <stdexcept>
+#include <cstdlib>
+
+
+namespace falcon {
+inline namespace container {
+namespace detail_ {
+
+/**
+ * Throws \c E(what), or calls std::abort() without exceptions.
+ *
+ * Not constexpr: reached during a constant evaluation, it stops the
+ * evaluation. Each error is a named function that calls it, so the
+ * diagnostic of the compiler shows the name of the error.
+ */
+template<class E>
+[[noreturn]] inline void throw_or_abort(char const * what)
+{
+#ifdef __cpp_exceptions
+  throw E(what);
+#else
+  (void)what;
+  std::abort();
+#endif
+}
+
+} // detail_
+} // container
+}
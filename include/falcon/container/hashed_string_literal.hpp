@@ -0,0 +1,115 @@
+/* The MIT License (MIT)
+
+Copyright (c) 2016 jonathan poelen
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/**
+* \author    Jonathan Poelen <jonathan.poelen+falcon@gmail.com>
+* \version   1.0
+* \brief     String literal with its precomputed hash
+*
+* \ingroup strings
+* \ingroup sequences
+*/
+
+#pragma once
+
+#include <falcon/container/string_literal.hpp>
+#include <falcon/functional/fnv.hpp>
+
+
+namespace falcon {
+inline namespace container {
+
+/**
+ * \brief  basic_string_literal that stores its FNV-1a hash.
+ *
+ * The hash is computed by the constructor, at compile time for a constexpr
+ * object, and is the value of \c std::hash<basic_string_literal> and
+ * \c string_id() for the same characters. std::hash and string_id() of a
+ * basic_hashed_string_literal return the stored value.
+ *
+ * \ingroup strings
+ * \ingroup sequences
+ *
+ * \tparam Ch  Type of character.
+ * \tparam N  Number of characters, not including any null-termination.
+ * \tparam Traits  Traits for character type.
+ */
+template<class Ch, std::size_t N, class Traits>
+struct basic_hashed_string_literal
+: basic_string_literal<Ch, N, Traits>
+{
+  constexpr explicit
+  basic_hashed_string_literal(
+    basic_string_literal<Ch, N, Traits> const & str) noexcept
+  : basic_string_literal<Ch, N, Traits>(str)
+  , hash_(fnv1a_hash_fn{}(str.data(), str.data() + str.size()))
+  {}
+
+  /// Returns the FNV-1a hash of the string.
+  constexpr std::size_t hash() const noexcept { return hash_; }
+
+  /// Returns the string without hash.
+  constexpr basic_string_literal<Ch, N, Traits> const &
+  str() const noexcept
+  { return *this; }
+
+private:
+  std::size_t hash_;
+};
+
+template<std::size_t n> using hashed_string_literal
+  = basic_hashed_string_literal<char, n>;
+template<std::size_t n> using hashed_wstring_literal
+  = basic_hashed_string_literal<wchar_t, n>;
+template<std::size_t n> using hashed_u16string_literal
+  = basic_hashed_string_literal<char16_t, n>;
+template<std::size_t n> using hashed_u32string_literal
+  = basic_hashed_string_literal<char32_t, n>;
+
+
+/// Creates a basic_hashed_string_literal object, deducing the target type from the types of arguments.
+template<class Ch, std::size_t N, class Tr>
+constexpr basic_hashed_string_literal<Ch, N, Tr>
+make_hashed_string_literal(basic_string_literal<Ch, N, Tr> const & str) noexcept
+{ return basic_hashed_string_literal<Ch, N, Tr>{str}; }
+
+/// Creates a basic_hashed_string_literal object, deducing the target type from the types of arguments.
+template<class Ch, class Tr = std::char_traits<Ch>, std::size_t N>
+constexpr basic_hashed_string_literal<Ch, N-1, Tr>
+make_hashed_string_literal(Ch const (&arr)[N]) noexcept
+{ return basic_hashed_string_literal<Ch, N-1, Tr>{make_string_literal<Ch, Tr>(arr)}; }
+
+} // container
+}
+
+namespace std
+{
+  template<class Ch, size_t N, class Tr>
+  struct hash<::falcon::container::basic_hashed_string_literal<Ch, N, Tr>>
+  {
+    constexpr size_t operator()(
+      ::falcon::container::basic_hashed_string_literal<Ch, N, Tr> const & k
+    ) const noexcept
+    { return k.hash(); }
+  };
+}
@@ -29,12 +29,15 @@ SOFTWARE.
 #pragma once
 
 #include <falcon/container/string_literal_fwd.hpp>
+#include <falcon/container/detail/string_literal_simd.hpp>
 #include <falcon/iostreams/ostream_insert.hpp>
+#include <falcon/cxx/is_constant_evaluated.hpp>
 #include <falcon/cxx/string_view.hpp>
 #include <falcon/functional/fnv.hpp>
 
 #include <iosfwd>
 #include <limits>
+#include <type_traits>
 #include <algorithm> // std::min
 
 #ifdef __cpp_exceptions
@@ -43,6 +46,7 @@ SOFTWARE.
 #endif
 
 #include <cstddef>
+#include <cstdint>
 #include <cstring>
 
 
@@ -59,8 +63,40 @@ namespace detail_
 
   struct core_access;
 
+  template<class Ch, class Tr> struct runtime_search;
+
   // fixes g++ -std=c++1z constexpr string_view
   template<class Ch, class Tr> struct string_view;
+
+  template<class Ch, class Tr> struct string_literal_algorithms;
+
+  template<class Ch, class Tr, std::size_t N>
+  constexpr bool
+  literal_equal(Ch const * s1, Ch const * s2, std::true_type) noexcept;
+
+  template<class Ch, class Tr, std::size_t N>
+  constexpr bool
+  literal_equal(Ch const *, Ch const *, std::false_type) noexcept
+  { return false; }
+
+  template<class Ch, class Tr, std::size_t N1, std::size_t N2>
+  constexpr int
+  literal_compare(Ch const * s1, Ch const * s2) noexcept;
+
+  template<std::size_t... Ns>
+  constexpr std::size_t sum_sizes() noexcept
+  {
+    std::size_t n = 0;
+    std::size_t const sizes[] {0, Ns...};
+    for (std::size_t sz : sizes) {
+      n += sz;
+    }
+    return n;
+  }
+
+  template<std::size_t N>
+  using uint_least_for = std::conditional_t<(N < 0x100u), std::uint8_t,
+    std::conditional_t<(N < 0x10000u), std::uint16_t, std::uint32_t>>;
 }
 
 
@@ -154,7 +190,7 @@ struct basic_string_literal
    */
   size_type copy(Ch * s, size_type n, size_type pos = 0) const
   {
-    auto v = view_("copy", n, pos);
+    auto v = view_("copy", pos, n);
     std::memcpy(s, v.data(), v.size());
     return v.size();
   }
@@ -172,7 +208,12 @@ struct basic_string_literal
    */
   template<std::size_t pos, std::size_t n = npos>
   constexpr basic_string_literal<Ch, std::min(n, N - pos), Traits>
-  substr() const noexcept;
+  substr() const noexcept
+  {
+    static_assert(pos < N, "out of range");
+    constexpr auto sz = std::min(n, N - pos);
+    return {detail_::private_ctor_str_lit{}, data_ + pos, sz};
+  }
 
   // string compare
   //@{
@@ -193,7 +234,7 @@ struct basic_string_literal
   template<std::size_t M>
   constexpr int
   compare(basic_string_literal<Ch, M, Traits> const & str) const noexcept
-  { return compare_(view_(), view_(str)); }
+  { return detail_::literal_compare<Ch, Traits, N, M>(data_, str.data()); }
 
   /**
    * \brief  Compare substring to a string.
@@ -343,11 +384,18 @@ struct basic_string_literal
    * \param pos  Index of character to search from (default 0).
    * \return  Index of first occurrence.
    *
+   * \throw  std::out_of_range  If \a pos > size().
+   *
    * Starting from \a pos, searches forward for \a c within this string.  If
    * found, returns the index where it was found.  If not found, returns npos.
    */
   constexpr size_type
-  find(Ch c, std::size_t pos = 0) const noexcept;
+  find(Ch c, std::size_t pos = 0) const
+  {
+    return pos <= size()
+      ? algorithms_().find(c, pos)
+      : (throw_out_of_range_("find", pos), npos);
+  }
 
   /**
    * \brief  Find position of a C substring.
@@ -377,6 +425,21 @@ struct basic_string_literal
   find(Ch const * s, size_type pos = 0) const noexcept
   { return find_({s}, pos); }
 
+  /**
+   * \brief  Find position of the pattern of a searcher.
+   * \param searcher  Searcher to use.
+   * \param pos  Index of character to search from (default 0).
+   * \return  Index of start of first occurrence.
+   *
+   * \note  Requires <falcon/container/string_literal_searcher.hpp>.
+   */
+  template<std::size_t M>
+  constexpr size_type
+  find(
+    basic_string_literal_searcher<Ch, M, Traits> const & searcher
+  , size_type pos = 0) const noexcept
+  { return searcher.find_in(data(), size(), pos); }
+
   /**
    * \brief  Find last position of a string.
    * \param str  String to locate.
@@ -394,6 +457,21 @@ struct basic_string_literal
   , size_type pos = npos) const noexcept
   { return rfind_(view_(str), pos); }
 
+  /**
+   * \brief  Find last position of the pattern of a searcher.
+   * \param searcher  Searcher to use.
+   * \param pos  Index of character to search back from (default end).
+   * \return  Index of start of last occurrence.
+   *
+   * \note  Requires <falcon/container/string_literal_searcher.hpp>.
+   */
+  template<std::size_t M>
+  constexpr size_type
+  rfind(
+    basic_string_literal_searcher<Ch, M, Traits> const & searcher
+  , size_type pos = npos) const noexcept
+  { return searcher.rfind_in(data(), size(), pos); }
+
   /**
    * \brief  Find last position of a character.
    * \param c  Character to locate.
@@ -404,7 +482,8 @@ struct basic_string_literal
    * found, returns the index where it was found.  If not found, returns npos.
    */
   constexpr size_type
-  rfind(Ch c, size_type pos = npos) const noexcept;
+  rfind(Ch c, size_type pos = npos) const noexcept
+  { return algorithms_().rfind(c, pos); }
 
   /**
    * \brief  Find last position of a C substring.
@@ -452,6 +531,21 @@ struct basic_string_literal
   , size_type pos = 0) const noexcept
   { return find_first_of_(view_(str), pos); }
 
+  /**
+   * \brief  Find position of a character of a charset.
+   * \param charset  Set of characters to locate.
+   * \param pos  Index of character to search from (default 0).
+   * \return  Index of first occurrence.
+   *
+   * \note  Requires <falcon/container/string_literal_charset.hpp>.
+   */
+  template<std::size_t M>
+  constexpr size_type
+  find_first_of(
+    basic_string_literal_charset<Ch, M, Traits> const & charset
+  , size_type pos = 0) const noexcept
+  { return charset.find_first_of_in(data(), size(), pos); }
+
   /**
    * \brief  Find position of a character.
    * \param c  Character to locate.
@@ -465,7 +559,7 @@ struct basic_string_literal
    * \note  Equivalent to find(c, pos).
    */
   constexpr size_type
-  find_first_of(Ch c, size_type pos = 0) const noexcept
+  find_first_of(Ch c, size_type pos = 0) const
   { return find(c, pos); }
 
   /**
@@ -515,6 +609,21 @@ struct basic_string_literal
   , size_type pos = npos) const noexcept
   { return find_last_of_(view_(str), pos); }
 
+  /**
+   * \brief  Find last position of a character of a charset.
+   * \param charset  Set of characters to locate.
+   * \param pos  Index of character to search back from (default end).
+   * \return  Index of last occurrence.
+   *
+   * \note  Requires <falcon/container/string_literal_charset.hpp>.
+   */
+  template<std::size_t M>
+  constexpr size_type
+  find_last_of(
+    basic_string_literal_charset<Ch, M, Traits> const & charset
+  , size_type pos = npos) const noexcept
+  { return charset.find_last_of_in(data(), size(), pos); }
+
   /**
    * \brief  Find last position of a character.
    * \param c  Character to locate.
@@ -577,6 +686,21 @@ struct basic_string_literal
   , size_type pos = 0) const noexcept
   { return find_first_not_of_(view_(str), pos); }
 
+  /**
+   * \brief  Find position of a character not in a charset.
+   * \param charset  Set of characters to avoid.
+   * \param pos  Index of character to search from (default 0).
+   * \return  Index of first occurrence.
+   *
+   * \note  Requires <falcon/container/string_literal_charset.hpp>.
+   */
+  template<std::size_t M>
+  constexpr size_type
+  find_first_not_of(
+    basic_string_literal_charset<Ch, M, Traits> const & charset
+  , size_type pos = 0) const noexcept
+  { return charset.find_first_not_of_in(data(), size(), pos); }
+
   /**
    * \brief  Find position of a different character.
    * \param c  Character to avoid.
@@ -588,7 +712,8 @@ struct basic_string_literal
    * If not found, returns npos.
    */
   constexpr size_type
-  find_first_not_of(Ch c, size_type pos = 0) const noexcept;
+  find_first_not_of(Ch c, size_type pos = 0) const noexcept
+  { return algorithms_().find_first_not_of(c, pos); }
 
   /**
    * \brief  Find position of a character not in C substring.
@@ -636,6 +761,21 @@ struct basic_string_literal
   , size_type pos = npos) const noexcept
   { return find_last_not_of_(view_(str), pos); }
 
+  /**
+   * \brief  Find last position of a character not in a charset.
+   * \param charset  Set of characters to avoid.
+   * \param pos  Index of character to search back from (default end).
+   * \return  Index of last occurrence.
+   *
+   * \note  Requires <falcon/container/string_literal_charset.hpp>.
+   */
+  template<std::size_t M>
+  constexpr size_type
+  find_last_not_of(
+    basic_string_literal_charset<Ch, M, Traits> const & charset
+  , size_type pos = npos) const noexcept
+  { return charset.find_last_not_of_in(data(), size(), pos); }
+
   /**
    * \brief  Find last position of a different character.
    * \param c  Character to avoid.
@@ -647,7 +787,8 @@ struct basic_string_literal
    * If not found, returns npos.
    */
   constexpr size_type
-  find_last_not_of(Ch c, size_type pos = npos) const noexcept;
+  find_last_not_of(Ch c, size_type pos = npos) const noexcept
+  { return algorithms_().find_last_not_of(c, pos); }
 
   /**
    * \brief  Find last position of a character not in C substring.
@@ -693,12 +834,12 @@ struct basic_string_literal
 
 #ifdef FALCON_STD_STRING_VIEW
   /// Creates a std::basic_string_view with the content of the current string.
-  constexpr FALCON_STD_STRING_VIEW<Ch, Traits> const &
+  constexpr FALCON_STD_STRING_VIEW<Ch, Traits>
   to_string_view() const
   { return {data(), size()}; }
 
   /// Creates a std::basic_string_view with the content of the current string.
-  constexpr operator FALCON_STD_STRING_VIEW<Ch, Traits> const & () const
+  constexpr operator FALCON_STD_STRING_VIEW<Ch, Traits> () const
   { return {data(), size()}; }
 #endif
 
@@ -728,46 +869,60 @@ private:
   template<std::size_t M>
   constexpr string_view_ view_(
     basic_string_literal<Ch, M, Traits> const & str
-  , char const * func, size_type pos, size_type n) const noexcept
+  , char const * func, size_type pos, size_type n) const
   {
-    return pos <= size()
+    return pos <= str.size()
       ? string_view_{
         str.data() + pos, std::min(n, size_type(str.size() - pos))
       } : (throw_out_of_range_(func, pos), string_view_{});
   }
 
   constexpr string_view_ view_(
-    char const * func, size_type pos, size_type n) const noexcept
+    char const * func, size_type pos, size_type n) const
   {
     return pos <= size()
       ? string_view_{data() + pos, std::min(n, size_type(size() - pos))}
       : (throw_out_of_range_(func, pos), string_view_{});
   }
 
-  constexpr int
-  compare_(string_view_ str1, string_view_ str2) const noexcept;
+  constexpr detail_::string_literal_algorithms<Ch, Traits>
+  algorithms_() const noexcept
+  { return {data_, N}; }
+
+  static constexpr int
+  compare_(string_view_ str1, string_view_ str2) noexcept
+  { return detail_::string_literal_algorithms<Ch, Traits>::compare_(str1, str2); }
 
   constexpr size_type
-  find_(string_view_ str, std::size_t pos) const noexcept;
+  find_(string_view_ str, std::size_t pos) const noexcept
+  { return algorithms_().find_(str, pos); }
 
   constexpr size_type
-  rfind_(string_view_ str, std::size_t pos) const noexcept;
+  rfind_(string_view_ str, std::size_t pos) const noexcept
+  { return algorithms_().rfind_(str, pos); }
 
   constexpr size_type
-  find_first_of_(string_view_ str, std::size_t pos) const noexcept;
+  find_first_of_(string_view_ str, std::size_t pos) const noexcept
+  { return algorithms_().find_first_of_(str, pos); }
 
   constexpr size_type
-  find_last_of_(string_view_ str, std::size_t pos) const noexcept;
+  find_last_of_(string_view_ str, std::size_t pos) const noexcept
+  { return algorithms_().find_last_of_(str, pos); }
 
   constexpr size_type
-  find_first_not_of_(string_view_ str, std::size_t pos) const noexcept;
+  find_first_not_of_(string_view_ str, std::size_t pos) const noexcept
+  { return algorithms_().find_first_not_of_(str, pos); }
 
   constexpr size_type
-  find_last_not_of_(string_view_ str, std::size_t pos) const noexcept;
+  find_last_not_of_(string_view_ str, std::size_t pos) const noexcept
+  { return algorithms_().find_last_not_of_(str, pos); }
 
 
   friend detail_::core_access;
 
+  template<class, std::size_t, class>
+  friend struct basic_string_literal;
+
   constexpr basic_string_literal(
     detail_::private_ctor_str_lit, Ch const * arr, std::size_t n) noexcept;
 
@@ -778,6 +933,12 @@ private:
     detail_::private_ctor_str_lit
   , Ch const * arr1, size_type n1
   , Ch const * arr2, size_type n2) noexcept;
+
+  template<std::size_t S, std::size_t... Ns>
+  constexpr basic_string_literal(
+    detail_::private_ctor_str_lit
+  , basic_string_literal<Ch, S, Traits> const & sep
+  , basic_string_literal<Ch, Ns, Traits> const & ... strs) noexcept;
 };
 
 
@@ -814,12 +975,17 @@ operator<<(
 
 // string comparison
 //@{
+/// Always false when the sizes differ, otherwise compared by words
+/// or by vectors at runtime.
 template<class Ch, class Tr, std::size_t n1, std::size_t n2>
 constexpr bool
 operator==(
   basic_string_literal<Ch, n1, Tr> const & x
 , basic_string_literal<Ch, n2, Tr> const & y) noexcept
-{ return n1 == n2 && x.compare(y) == 0; }
+{
+  return detail_::literal_equal<Ch, Tr, n1>(
+    x.data(), y.data(), std::integral_constant<bool, n1 == n2>{});
+}
 
 template<class Ch, class Tr, std::size_t n>
 constexpr bool
@@ -938,6 +1104,13 @@ namespace detail_
       Ch const * arr1, std::size_t n1,
       Ch const * arr2, std::size_t n2) noexcept
     { return {detail_::private_ctor_str_lit{}, arr1, n1, arr2, n2}; }
+
+    template<std::size_t N, class Tr, class Ch, std::size_t S, std::size_t... Ns>
+    static constexpr basic_string_literal<Ch, N, Tr>
+    mk_lit(
+      basic_string_literal<Ch, S, Tr> const & sep,
+      basic_string_literal<Ch, Ns, Tr> const & ... strs) noexcept
+    { return {detail_::private_ctor_str_lit{}, sep, strs...}; }
   };
 }
 
@@ -1015,6 +1188,43 @@ operator+(basic_string_literal<Ch, n, Tr> const & x, Ch y) noexcept
     mk_lit<n+1, Tr>(x.data(), x.size(), &y, 1);
 }
 
+/**
+ * \brief  Concatenates several strings.
+ * \return  The new string.
+ *
+ * Equivalent to <code>strs + ...</code>, but the result type is computed
+ * once and each character is copied only once, where a chain of operator+
+ * creates and copies every intermediate string.
+ */
+template<class Ch, class Tr, std::size_t... Ns>
+constexpr basic_string_literal<Ch, detail_::sum_sizes<Ns...>(), Tr>
+concat(basic_string_literal<Ch, Ns, Tr> const & ... strs) noexcept
+{
+  return detail_::core_access::mk_lit<detail_::sum_sizes<Ns...>(), Tr>(
+    detail_::core_access::mk_lit<0, Tr>(static_cast<Ch const *>(nullptr), 0),
+    strs...);
+}
+
+/**
+ * \brief  Concatenates several strings separated by \a sep.
+ * \return  The new string.
+ *
+ * Like concat(), each character is copied only once.
+ */
+template<class Ch, class Tr, std::size_t S, std::size_t... Ns>
+constexpr basic_string_literal<Ch,
+  detail_::sum_sizes<Ns...>() + S * (sizeof...(Ns) ? sizeof...(Ns) - 1 : 0),
+  Tr>
+join(
+  basic_string_literal<Ch, S, Tr> const & sep
+, basic_string_literal<Ch, Ns, Tr> const & ... strs) noexcept
+{
+  return detail_::core_access::mk_lit<
+    detail_::sum_sizes<Ns...>() + S * (sizeof...(Ns) ? sizeof...(Ns) - 1 : 0),
+    Tr
+  >(sep, strs...);
+}
+
 namespace detail_ {
 
 inline constexpr unsigned digits10_for(bool)
@@ -1030,24 +1240,163 @@ constexpr unsigned digits10_for(T val)
   return n;
 }
 
+inline constexpr char digit_char(unsigned d) noexcept
+{ return "0123456789abcdefghijklmnopqrstuvwxyz"[d]; }
+
+/// "00" "01" ... for the Base*Base values of 2 digits.
+template<class Ch, unsigned Base>
+struct digit_pairs
+{
+  Ch data[Base * Base * 2];
+
+  constexpr digit_pairs() noexcept
+  : data{}
+  {
+    for (unsigned i = 0; i < Base * Base; ++i) {
+      data[i * 2] = Ch(digit_char(i / Base));
+      data[i * 2 + 1] = Ch(digit_char(i % Base));
+    }
+  }
+};
+
+template<class Ch, unsigned Base>
+struct digit_pairs_table
+{ static constexpr digit_pairs<Ch, Base> value{}; };
+
+template<class Ch, unsigned Base>
+constexpr digit_pairs<Ch, Base> digit_pairs_table<Ch, Base>::value;
+
+template<class T>
+using integer_unsigned_t = std::make_unsigned_t<
+  std::conditional_t<std::is_same<T, bool>::value, unsigned, T>>;
+
+/// unsigned arithmetic, at least unsigned int
+template<class T>
+using integer_work_t = std::conditional_t<
+  (sizeof(integer_unsigned_t<T>) <= sizeof(unsigned)),
+  unsigned, integer_unsigned_t<T>>;
+
+template<class T>
+constexpr bool is_negative(T, std::false_type) noexcept
+{ return false; }
+
+template<class T>
+constexpr bool is_negative(T x, std::true_type) noexcept
+{ return x < T(0); }
+
+template<class T>
+constexpr integer_work_t<T> integer_abs(T x) noexcept
+{
+  using U = integer_work_t<T>;
+  return is_negative(x, std::is_signed<T>{})
+    ? U(U(0u) - U(x))
+    : U(x);
+}
+
+/// Number of digits, 4 digits per division.
+template<unsigned Base, class U>
+constexpr std::size_t count_digits(U u) noexcept
+{
+  constexpr U b1 = Base;
+  constexpr U b2 = b1 * Base;
+  constexpr U b3 = b2 * Base;
+  constexpr U b4 = b3 * Base;
+  std::size_t n = 1;
+  for (;;) {
+    if (u < b1) return n;
+    if (u < b2) return n + 1;
+    if (u < b3) return n + 2;
+    if (u < b4) return n + 3;
+    u /= b4;
+    n += 4;
+  }
+}
+
+}
+
+/**
+ * \brief  Number of characters written by write_integer<Base>(out, x, width).
+ */
+template<unsigned Base = 10, class T>
+constexpr std::size_t
+integer_size(T x, std::size_t width = 0) noexcept
+{
+  static_assert(Base >= 2 && Base <= 36, "Base must be in [2, 36]");
+  std::size_t const n
+    = std::size_t(detail_::is_negative(x, std::is_signed<T>{}))
+    + detail_::count_digits<Base>(detail_::integer_abs(x));
+  return n < width ? width : n;
+}
+
+/**
+ * \brief  Writes \a x in base \a Base (lower case digits), without null character.
+ * \param width  Minimal size, the digits are padded with '0' after the sign.
+ * \return  \a out + integer_size<Base>(x, width).
+ *
+ * Two digits are emitted per division with a table of the Base*Base pairs.
+ */
+template<unsigned Base = 10, class Ch, class T>
+constexpr Ch *
+write_integer(Ch * out, T x, std::size_t width = 0) noexcept
+{
+  static_assert(Base >= 2 && Base <= 36, "Base must be in [2, 36]");
+  using U = detail_::integer_work_t<T>;
+  constexpr U base2 = U(Base) * Base;
+  Ch const * const pairs = detail_::digit_pairs_table<Ch, Base>::value.data;
+
+  bool const neg = detail_::is_negative(x, std::is_signed<T>{});
+  U u = detail_::integer_abs(x);
+  std::size_t const ndigits = detail_::count_digits<Base>(u);
+  std::size_t const total = std::size_t(neg) + ndigits;
+
+  if (neg) {
+    *out++ = Ch('-');
+  }
+  Ch * const end = out + ((total < width ? width : total) - std::size_t(neg));
+  for (Ch * const e = end - ndigits; out != e; ++out) {
+    *out = Ch('0');
+  }
+
+  Ch * p = end;
+  while (u >= base2) {
+    std::size_t const i = std::size_t(u % base2) * 2;
+    u /= base2;
+    *--p = pairs[i + 1];
+    *--p = pairs[i];
+  }
+  if (u >= Base) {
+    *--p = pairs[u * 2 + 1];
+    *--p = pairs[u * 2];
+  }
+  else {
+    *--p = Ch(detail_::digit_char(unsigned(u)));
+  }
+  return end;
 }
 
+
 template<class Ch, class T, T val_, class Tr = std::char_traits<Ch>>
 constexpr basic_string_literal<Ch, detail_::digits10_for(val_), Tr>
 to_basic_string_literal() noexcept
 {
   constexpr unsigned sz = detail_::digits10_for(val_);
-  T val = val_;
   Ch buf[sz]{};
-  Ch * p = buf + sz;
-  if (val < 0) {
-    buf[0] = '-';
-    *--p = char(-(val % 10) + '0');
-    val = -(val / T(10));
-  }
-  do {
-    *--p = char(val % 10 + '0');
-  } while (val /= T(10));
+  write_integer<10>(buf, val_);
+  return detail_::core_access::mk_lit<sz, Tr>(buf, sz);
+}
+
+/**
+ * \brief  Converts \a val in base \a Base.
+ * \tparam Width  Minimal size, the digits are padded with '0' after the sign.
+ */
+template<class Ch, unsigned Base, class T, T val, std::size_t Width = 0,
+  class Tr = std::char_traits<Ch>>
+constexpr basic_string_literal<Ch, integer_size<Base>(val, Width), Tr>
+to_basic_string_literal_base() noexcept
+{
+  constexpr std::size_t sz = integer_size<Base>(val, Width);
+  Ch buf[sz]{};
+  write_integer<Base>(buf, val, Width);
   return detail_::core_access::mk_lit<sz, Tr>(buf, sz);
 }
 
@@ -1062,32 +1411,51 @@ constexpr string_literal<detail_::digits10_for(val)>
 to_string_literal_u() noexcept
 { return to_basic_string_literal<char, unsigned long long, val>(); }
 
+template<unsigned long long val, std::size_t Width = 0>
+constexpr string_literal<integer_size<16>(val, Width)>
+to_string_literal_hex() noexcept
+{ return to_basic_string_literal_base<char, 16, unsigned long long, val, Width>(); }
+
+template<unsigned long long val, std::size_t Width = 0>
+constexpr string_literal<integer_size<8>(val, Width)>
+to_string_literal_oct() noexcept
+{ return to_basic_string_literal_base<char, 8, unsigned long long, val, Width>(); }
+
+template<unsigned long long val, std::size_t Width = 0>
+constexpr string_literal<integer_size<2>(val, Width)>
+to_string_literal_bin() noexcept
+{ return to_basic_string_literal_base<char, 2, unsigned long long, val, Width>(); }
+
 
 template<long long val>
-constexpr string_literal<detail_::digits10_for(val)>
+constexpr wstring_literal<detail_::digits10_for(val)>
 to_wstring_literal_i() noexcept
 { return to_basic_string_literal<wchar_t, long long, val>(); }
 
 template<unsigned long long val>
-constexpr string_literal<detail_::digits10_for(val)>
+constexpr wstring_literal<detail_::digits10_for(val)>
 to_wstring_literal_u() noexcept
 { return to_basic_string_literal<wchar_t, unsigned long long, val>(); }
 
+template<unsigned long long val, std::size_t Width = 0>
+constexpr wstring_literal<integer_size<16>(val, Width)>
+to_wstring_literal_hex() noexcept
+{ return to_basic_string_literal_base<wchar_t, 16, unsigned long long, val, Width>(); }
 
+template<unsigned long long val, std::size_t Width = 0>
+constexpr wstring_literal<integer_size<8>(val, Width)>
+to_wstring_literal_oct() noexcept
+{ return to_basic_string_literal_base<wchar_t, 8, unsigned long long, val, Width>(); }
 
-// Implementation
+template<unsigned long long val, std::size_t Width = 0>
+constexpr wstring_literal<integer_size<2>(val, Width)>
+to_wstring_literal_bin() noexcept
+{ return to_basic_string_literal_base<wchar_t, 2, unsigned long long, val, Width>(); }
 
 
-template<class Ch, std::size_t N, class Tr>
-template<std::size_t pos, std::size_t n>
-constexpr basic_string_literal<Ch, std::min(n, N - pos), Tr>
-basic_string_literal<Ch, N, Tr>
-::substr() const noexcept
-{
-  static_assert(pos < N, "out of range");
-  constexpr auto sz = std::min(n, N - pos);
-  return detail_::core_access::mk_lit<sz, Tr>(data_ + pos, sz);
-}
+
+// Implementation
+
 
 #ifdef __cpp_exceptions
 template<class Ch, std::size_t N, class Tr>
@@ -1130,35 +1498,96 @@ namespace detail_
     constexpr const_pointer data() const noexcept { return s; }
     constexpr Ch const & operator[](std::size_t i) const noexcept { return s[i]; }
   };
+
+  /// Search and comparison algorithms of basic_string_literal and
+  /// basic_literal_ref on \a size_ characters at \a data_.
+  template<class Ch, class Tr>
+  struct string_literal_algorithms
+  {
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using traits_type = Tr;
+    using expr_traits = constexpr_char_traits<Ch, Tr>;
+    using string_view_ = string_view<Ch, Tr>;
+
+    static constexpr size_type npos = size_type(-1);
+
+    Ch const * data_;
+    size_type size_;
+
+    constexpr size_type size() const noexcept { return size_; }
+
+    static constexpr int
+    compare_(string_view_ str1, string_view_ str2) noexcept;
+
+    /// Result of compare_() for equal prefixes.
+    static constexpr int
+    size_diff_(size_type n1, size_type n2) noexcept;
+
+    constexpr size_type find(Ch c, size_type pos) const noexcept;
+    constexpr size_type find_(string_view_ str, size_type pos) const noexcept;
+    constexpr size_type rfind(Ch c, size_type pos) const noexcept;
+    constexpr size_type rfind_(string_view_ str, size_type pos) const noexcept;
+    constexpr size_type
+    find_first_of_(string_view_ str, size_type pos) const noexcept;
+    constexpr size_type
+    find_last_of_(string_view_ str, size_type pos) const noexcept;
+    constexpr size_type
+    find_first_not_of(Ch c, size_type pos) const noexcept;
+    constexpr size_type
+    find_first_not_of_(string_view_ str, size_type pos) const noexcept;
+    constexpr size_type
+    find_last_not_of(Ch c, size_type pos) const noexcept;
+    constexpr size_type
+    find_last_not_of_(string_view_ str, size_type pos) const noexcept;
+  };
 }
 
-template<class Ch, std::size_t N, class Tr>
+template<class Ch, class Tr>
 constexpr int
-basic_string_literal<Ch, N, Tr>
-::compare_(string_view_ str1, string_view_ str2) const noexcept
+detail_::string_literal_algorithms<Ch, Tr>
+::compare_(string_view_ str1, string_view_ str2) noexcept
 {
   int ret = expr_traits
     ::compare(str1.data(), str2.data(), std::min(str1.size(), str2.size()));
   if (0 == ret) {
-    using limits = std::numeric_limits<int>;
-    auto diff = static_cast<difference_type>(str1.size() - str2.size());
-    ret = diff > limits::max() ? limits::max()
-      : diff < limits::min() ? limits::min()
-      : static_cast<int>(diff);
+    ret = size_diff_(str1.size(), str2.size());
   }
   return ret;
 }
 
+template<class Ch, class Tr>
+constexpr int
+detail_::string_literal_algorithms<Ch, Tr>
+::size_diff_(size_type n1, size_type n2) noexcept
+{
+  using limits = std::numeric_limits<int>;
+  auto diff = static_cast<difference_type>(n1 - n2);
+  return diff > limits::max() ? limits::max()
+    : diff < limits::min() ? limits::min()
+    : static_cast<int>(diff);
+}
+
 
-template<class Ch, std::size_t N, class Tr>
-constexpr typename basic_string_literal<Ch, N, Tr>::size_type
-basic_string_literal<Ch, N, Tr>
+template<class Ch, class Tr>
+constexpr std::size_t
+detail_::string_literal_algorithms<Ch, Tr>
 ::find(Ch c, size_type pos) const noexcept
 {
-  size_type ret = (pos <= size())
-    ? npos
-    : (throw_out_of_range_("find", pos), npos);
+  size_type ret = npos;
   if (pos < size()) {
+#ifdef FALCON_IS_CONSTANT_EVALUATED
+    // expr_traits::find fails with gcc on a temporary of a namespace scope
+    // constant (the result is not comparable with nullptr)
+    if (FALCON_IS_CONSTANT_EVALUATED()) {
+      for (; pos < size(); ++pos) {
+        if (traits_type::eq(data_[pos], c)) {
+          return pos;
+        }
+      }
+      return ret;
+    }
+#endif
     size_type const n = size() - pos;
     Ch const * p = expr_traits::find(data_ + pos, n, c);
 #if defined(__clang__) || (defined(__GNUC__) && __GNUC__ >= 6)
@@ -1173,15 +1602,23 @@ basic_string_literal<Ch, N, Tr>
   return ret;
 }
 
-template<class Ch, std::size_t N, class Tr>
-constexpr typename basic_string_literal<Ch, N, Tr>::size_type
-basic_string_literal<Ch, N, Tr>
+template<class Ch, class Tr>
+constexpr std::size_t
+detail_::string_literal_algorithms<Ch, Tr>
 ::find_(string_view_ str, std::size_t pos) const noexcept
 {
   if (str.size() == 0) {
     return pos <= size() ? pos : npos;
   }
 
+#ifdef FALCON_IS_CONSTANT_EVALUATED
+  if (detail_::runtime_search<Ch, Tr>::enabled
+    && !FALCON_IS_CONSTANT_EVALUATED()) {
+    return detail_::runtime_search<Ch, Tr>
+      ::find(data_, size(), str.data(), str.size(), pos);
+  }
+#endif
+
   if (str.size() <= size()) {
     for (; pos <= size() - str.size(); ++pos) {
       if (traits_type::eq(data_[pos], str[0])
@@ -1196,9 +1633,9 @@ basic_string_literal<Ch, N, Tr>
   return npos;
 }
 
-template<class Ch, std::size_t N, class Tr>
-constexpr typename basic_string_literal<Ch, N, Tr>::size_type
-basic_string_literal<Ch, N, Tr>
+template<class Ch, class Tr>
+constexpr std::size_t
+detail_::string_literal_algorithms<Ch, Tr>
 ::rfind(Ch c, size_type pos) const noexcept
 {
   size_type sz = size();
@@ -1215,11 +1652,19 @@ basic_string_literal<Ch, N, Tr>
   return npos;
 }
 
-template<class Ch, std::size_t N, class Tr>
-constexpr typename basic_string_literal<Ch, N, Tr>::size_type
-basic_string_literal<Ch, N, Tr>
+template<class Ch, class Tr>
+constexpr std::size_t
+detail_::string_literal_algorithms<Ch, Tr>
 ::rfind_(string_view_ str, std::size_t pos) const noexcept
 {
+#ifdef FALCON_IS_CONSTANT_EVALUATED
+  if (detail_::runtime_search<Ch, Tr>::enabled && str.size()
+    && !FALCON_IS_CONSTANT_EVALUATED()) {
+    return detail_::runtime_search<Ch, Tr>
+      ::rfind(data_, size(), str.data(), str.size(), pos);
+  }
+#endif
+
   if (str.size() <= size()) {
     pos = std::min(size_type(size() - str.size()), pos);
     do {
@@ -1235,9 +1680,9 @@ basic_string_literal<Ch, N, Tr>
   return npos;
 }
 
-template<class Ch, std::size_t N, class Tr>
-constexpr typename basic_string_literal<Ch, N, Tr>::size_type
-basic_string_literal<Ch, N, Tr>
+template<class Ch, class Tr>
+constexpr std::size_t
+detail_::string_literal_algorithms<Ch, Tr>
 ::find_first_of_(string_view_ str, std::size_t pos) const noexcept
 {
   if (str.size()) {
@@ -1258,9 +1703,9 @@ basic_string_literal<Ch, N, Tr>
   return npos;
 }
 
-template<class Ch, std::size_t N, class Tr>
-constexpr typename basic_string_literal<Ch, N, Tr>::size_type
-basic_string_literal<Ch, N, Tr>
+template<class Ch, class Tr>
+constexpr std::size_t
+detail_::string_literal_algorithms<Ch, Tr>
 ::find_last_of_(string_view_ str, std::size_t pos) const noexcept
 {
   size_type sz = this->size();
@@ -1286,9 +1731,9 @@ basic_string_literal<Ch, N, Tr>
   return npos;
 }
 
-template<class Ch, std::size_t N, class Tr>
-constexpr typename basic_string_literal<Ch, N, Tr>::size_type
-basic_string_literal<Ch, N, Tr>
+template<class Ch, class Tr>
+constexpr std::size_t
+detail_::string_literal_algorithms<Ch, Tr>
 ::find_first_not_of(Ch c, size_type pos) const noexcept
 {
   for (; pos < size(); ++pos) {
@@ -1299,9 +1744,9 @@ basic_string_literal<Ch, N, Tr>
   return npos;
 }
 
-template<class Ch, std::size_t N, class Tr>
-constexpr typename basic_string_literal<Ch, N, Tr>::size_type
-basic_string_literal<Ch, N, Tr>
+template<class Ch, class Tr>
+constexpr std::size_t
+detail_::string_literal_algorithms<Ch, Tr>
 ::find_first_not_of_(string_view_ str, std::size_t pos) const noexcept
 {
   for (; pos < size(); ++pos) {
@@ -1320,9 +1765,9 @@ basic_string_literal<Ch, N, Tr>
   return npos;
 }
 
-template<class Ch, std::size_t N, class Tr>
-constexpr typename basic_string_literal<Ch, N, Tr>::size_type
-basic_string_literal<Ch, N, Tr>
+template<class Ch, class Tr>
+constexpr std::size_t
+detail_::string_literal_algorithms<Ch, Tr>
 ::find_last_not_of(Ch c, size_type pos) const noexcept
 {
   size_type sz = size();
@@ -1340,9 +1785,9 @@ basic_string_literal<Ch, N, Tr>
   return npos;
 }
 
-template<class Ch, std::size_t N, class Tr>
-constexpr typename basic_string_literal<Ch, N, Tr>::size_type
-basic_string_literal<Ch, N, Tr>
+template<class Ch, class Tr>
+constexpr std::size_t
+detail_::string_literal_algorithms<Ch, Tr>
 ::find_last_not_of_(string_view_ str, std::size_t pos) const noexcept
 {
   size_type sz = size();
@@ -1384,6 +1829,14 @@ namespace detail_ {
 
 template<class Ch>
 constexpr Ch * acpy(Ch * p, Ch const * arr, std::size_t n) noexcept {
+#ifdef FALCON_IS_CONSTANT_EVALUATED
+  if (!FALCON_IS_CONSTANT_EVALUATED()) {
+    if (n) {
+      std::memcpy(p, arr, n * sizeof(Ch));
+    }
+    return p + n;
+  }
+#endif
   Ch * e = p + n;
   while (p != e) {
     *p++ = *arr++;
@@ -1400,12 +1853,29 @@ constexpr basic_string_literal<Ch, N, Tr>::basic_string_literal(
 
 template<class Ch, std::size_t N, class Tr>
 constexpr basic_string_literal<Ch, N, Tr>::basic_string_literal(
-  detail_::private_ctor_str_lit ctor
+  detail_::private_ctor_str_lit
 , Ch const * arr1, size_type n1
 , Ch const * arr2, size_type n2) noexcept
-: basic_string_literal(ctor, arr1, n1)
 { detail_::acpy(detail_::acpy(data_, arr1, n1), arr2, n2); }
 
+template<class Ch, std::size_t N, class Tr>
+template<std::size_t S, std::size_t... Ns>
+constexpr basic_string_literal<Ch, N, Tr>::basic_string_literal(
+  detail_::private_ctor_str_lit
+, basic_string_literal<Ch, S, Tr> const & sep
+, basic_string_literal<Ch, Ns, Tr> const & ... strs) noexcept
+{
+  Ch * p = data_;
+  std::size_t i = 0;
+  int const unpack[] {0, (
+    p = detail_::acpy(p, strs.data(), strs.size()),
+    p = (++i < sizeof...(Ns)) ? detail_::acpy(p, sep.data(), S) : p,
+    0
+  )...};
+  (void)unpack;
+  (void)p;
+}
+
 
 namespace detail_
 {
@@ -1425,12 +1895,22 @@ namespace detail_
     { return Tr::length(p); }
   };
 
+  /// Constexpr algorithms of std::char_traits<Ch>, that call those of
+  /// std::char_traits (memcmp, memchr, strlen, etc) when the call is not
+  /// constant-evaluated.
   template<class Ch>
   struct constexpr_std_char_traits
   {
     static constexpr int
     compare(Ch const * s1, Ch const * s2, std::size_t n) noexcept
     {
+#ifdef FALCON_IS_CONSTANT_EVALUATED
+      if (!FALCON_IS_CONSTANT_EVALUATED()) {
+        // normalized to -1, 0, 1 like the constexpr algorithm
+        int const r = std::char_traits<Ch>::compare(s1, s2, n);
+        return r < 0 ? -1 : r > 0 ? 1 : 0;
+      }
+#endif
       Ch const * e1 = s1 + n;
       while (s1 != e1 && std::char_traits<Ch>::eq(*s1, *s2)) {
         ++s1, ++s2;
@@ -1441,6 +1921,11 @@ namespace detail_
     static constexpr Ch const *
     find(Ch const * p, std::size_t n, Ch const & ch) noexcept
     {
+#ifdef FALCON_IS_CONSTANT_EVALUATED
+      if (!FALCON_IS_CONSTANT_EVALUATED()) {
+        return std::char_traits<Ch>::find(p, n, ch);
+      }
+#endif
       Ch const * e = p + n;
       for (; p != e; ++p) {
         if (std::char_traits<Ch>::eq(*p, ch)) {
@@ -1453,6 +1938,11 @@ namespace detail_
     static constexpr std::size_t
     length(Ch const * p) noexcept
     {
+#ifdef FALCON_IS_CONSTANT_EVALUATED
+      if (!FALCON_IS_CONSTANT_EVALUATED()) {
+        return std::char_traits<Ch>::length(p);
+      }
+#endif
       std::size_t n = 0;
       for (; *p; ++p) {
         ++n;
@@ -1480,6 +1970,148 @@ namespace detail_
   struct constexpr_char_traits<char32_t, std::char_traits<char32_t>>
   : constexpr_std_char_traits<char32_t>
   {};
+
+
+  /// Non constexpr substring search, selected by find_() and rfind_()
+  /// when the call is not constant-evaluated.
+  /// The results are identical to those of the constexpr algorithms.
+  template<class Ch, class Tr>
+  struct runtime_search
+  {
+    static constexpr bool enabled = false;
+
+    // never called
+    static std::size_t find(
+      Ch const *, std::size_t, Ch const *, std::size_t, std::size_t) noexcept
+    { return std::size_t(-1); }
+
+    static std::size_t rfind(
+      Ch const *, std::size_t, Ch const *, std::size_t, std::size_t) noexcept
+    { return std::size_t(-1); }
+  };
+
+#ifdef FALCON_STRING_LITERAL_SIMD
+  template<>
+  struct runtime_search<char, std::char_traits<char>>
+  {
+    static constexpr bool enabled = true;
+
+    /// \pre 0 < m
+    static std::size_t find(
+      char const * s, std::size_t n,
+      char const * w, std::size_t m, std::size_t pos) noexcept
+    { return simd::find(s, n, w, m, pos); }
+
+    /// \pre 0 < m
+    static std::size_t rfind(
+      char const * s, std::size_t n,
+      char const * w, std::size_t m, std::size_t pos) noexcept
+    { return simd::rfind(s, n, w, m, pos); }
+  };
+#endif
+
+
+  /// Non constexpr comparisons of strings of the same size, selected by
+  /// literal_equal() and literal_compare() when the call is not
+  /// constant-evaluated.
+  template<class Ch, class Tr>
+  struct runtime_compare
+  {
+    static constexpr bool equal_enabled = false;
+    static constexpr bool compare_enabled = false;
+
+    // never called
+    static bool equal(Ch const *, Ch const *, std::size_t) noexcept
+    { return false; }
+
+    static int compare(Ch const *, Ch const *, std::size_t) noexcept
+    { return 0; }
+  };
+
+  /// Bytewise equality is the equality of std::char_traits.
+  template<class Ch>
+  struct runtime_std_compare
+  : runtime_compare<Ch, void>
+  {
+    static constexpr bool equal_enabled = true;
+
+    /// Beyond, the unrolled loops of memcmp are faster.
+    static constexpr std::size_t inline_max_bytes = 128;
+
+    /// \a n is a constant after inlining, only one branch remains
+    static bool equal(Ch const * s1, Ch const * s2, std::size_t n) noexcept
+    {
+      if (n * sizeof(Ch) > inline_max_bytes) {
+        return 0 == std::memcmp(s1, s2, n * sizeof(Ch));
+      }
+      return simd::equal_bytes(
+        reinterpret_cast<char const *>(s1),
+        reinterpret_cast<char const *>(s2),
+        n * sizeof(Ch));
+    }
+  };
+
+  template<>
+  struct runtime_compare<char, std::char_traits<char>>
+  : runtime_std_compare<char>
+  {
+    // std::char_traits<char>::lt compares unsigned char, like memcmp
+    static constexpr bool compare_enabled = true;
+
+    static int compare(char const * s1, char const * s2, std::size_t n) noexcept
+    {
+      if (n > inline_max_bytes) {
+        int const r = std::memcmp(s1, s2, n);
+        return r < 0 ? -1 : r > 0 ? 1 : 0;
+      }
+      return simd::compare_bytes(s1, s2, n);
+    }
+  };
+
+  template<>
+  struct runtime_compare<wchar_t, std::char_traits<wchar_t>>
+  : runtime_std_compare<wchar_t>
+  {};
+
+  template<>
+  struct runtime_compare<char16_t, std::char_traits<char16_t>>
+  : runtime_std_compare<char16_t>
+  {};
+
+  template<>
+  struct runtime_compare<char32_t, std::char_traits<char32_t>>
+  : runtime_std_compare<char32_t>
+  {};
+
+
+  template<class Ch, class Tr, std::size_t N>
+  constexpr bool
+  literal_equal(Ch const * s1, Ch const * s2, std::true_type) noexcept
+  {
+#ifdef FALCON_IS_CONSTANT_EVALUATED
+    if (runtime_compare<Ch, Tr>::equal_enabled
+      && !FALCON_IS_CONSTANT_EVALUATED()) {
+      return runtime_compare<Ch, Tr>::equal(s1, s2, N);
+    }
+#endif
+    return 0 == constexpr_char_traits<Ch, Tr>::compare(s1, s2, N);
+  }
+
+  template<class Ch, class Tr, std::size_t N1, std::size_t N2>
+  constexpr int
+  literal_compare(Ch const * s1, Ch const * s2) noexcept
+  {
+#ifdef FALCON_IS_CONSTANT_EVALUATED
+    if (runtime_compare<Ch, Tr>::compare_enabled
+      && !FALCON_IS_CONSTANT_EVALUATED()) {
+      int const ret = runtime_compare<Ch, Tr>
+        ::compare(s1, s2, N1 < N2 ? N1 : N2);
+      return ret ? ret
+        : string_literal_algorithms<Ch, Tr>::size_diff_(N1, N2);
+    }
+#endif
+    return string_literal_algorithms<Ch, Tr>::compare_({s1, N1}, {s2, N2});
+  }
 }
 
 } // container
@@ -0,0 +1,244 @@
+/* The MIT License (MIT)
+
+Copyright (c) 2016 jonathan poelen
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/**
+* \author    Jonathan Poelen <jonathan.poelen+falcon@gmail.com>
+* \version   1.0
+* \brief     ASCII case conversions and case-insensitive traits
+*
+* \ingroup strings
+*/
+
+#pragma once
+
+#include <falcon/container/string_literal.hpp>
+#include <falcon/container/string_literal_fwd.hpp>
+#include <falcon/container/detail/string_literal_simd.hpp>
+#include <falcon/cxx/is_constant_evaluated.hpp>
+#include <falcon/functional/fnv.hpp>
+
+#include <string>
+#include <type_traits>
+
+
+namespace falcon {
+inline namespace container {
+
+/**
+ * \brief  Character traits that ignore the case of ASCII letters.
+ *
+ * Usable as the \c Traits of basic_string_literal: compare(), find(),
+ * operator== and the other comparison operators are then case-insensitive
+ * ("Content-Length" == "content-length"). The order is the one of the
+ * lowercase strings. The non-ASCII characters are compared as with
+ * std::char_traits.
+ *
+ * With \c char, the runtime comparisons and find(Ch) convert 16 or 32
+ * characters at a time with a vector mask.
+ *
+ * \code
+ * constexpr auto content_length = ci_lit("Content-Length");
+ * bool is_content_length(std::string_view name)
+ * {
+ *   return 0 == content_length.compare(
+ *     0, content_length.size(), name.data(), name.size());
+ * }
+ * \endcode
+ */
+template<class Ch>
+struct ci_char_traits
+: std::char_traits<Ch>
+{
+  using char_type = Ch;
+
+  static constexpr bool eq(Ch a, Ch b) noexcept
+  { return detail_::ascii_to_lower(a) == detail_::ascii_to_lower(b); }
+
+  static constexpr bool lt(Ch a, Ch b) noexcept
+  { return key_(detail_::ascii_to_lower(a)) < key_(detail_::ascii_to_lower(b)); }
+
+  static constexpr int compare(Ch const * s1, Ch const * s2, std::size_t n) noexcept
+  {
+    for (std::size_t i = 0; i < n; ++i) {
+      if (!eq(s1[i], s2[i])) {
+        return lt(s1[i], s2[i]) ? -1 : 1;
+      }
+    }
+    return 0;
+  }
+
+  static constexpr Ch const * find(Ch const * p, std::size_t n, Ch const & c) noexcept
+  {
+    for (Ch const * e = p + n; p != e; ++p) {
+      if (eq(*p, c)) {
+        return p;
+      }
+    }
+    return nullptr;
+  }
+
+  static constexpr std::size_t length(Ch const * p) noexcept
+  {
+    std::size_t n = 0;
+    for (; !eq(*p, Ch()); ++p) {
+      ++n;
+    }
+    return n;
+  }
+
+private:
+  // the order of std::char_traits: char is compared as unsigned char
+  using key_type_ = std::conditional_t<std::is_same<Ch, char>::value, unsigned char, Ch>;
+
+  static constexpr key_type_ key_(Ch c) noexcept
+  { return static_cast<key_type_>(c); }
+};
+
+template<std::size_t n> using ci_string_literal
+  = basic_string_literal<char, n, ci_char_traits<char>>;
+template<std::size_t n> using ci_wstring_literal
+  = basic_string_literal<wchar_t, n, ci_char_traits<wchar_t>>;
+
+
+namespace detail_
+{
+  template<class Ch, std::size_t N, class ToTr, class Tr, class F>
+  constexpr basic_string_literal<Ch, N, ToTr>
+  transform_literal(basic_string_literal<Ch, N, Tr> const & str, F f) noexcept
+  {
+    Ch buf[N + 1] {};
+    for (std::size_t i = 0; i < N; ++i) {
+      buf[i] = f(str[i]);
+    }
+    return core_access::mk_lit<N, ToTr>(buf, N);
+  }
+
+  template<>
+  struct constexpr_char_traits<char, ci_char_traits<char>>
+  {
+    static constexpr int
+    compare(char const * s1, char const * s2, std::size_t n) noexcept
+    {
+#ifdef FALCON_IS_CONSTANT_EVALUATED
+      if (!FALCON_IS_CONSTANT_EVALUATED()) {
+        std::size_t const i = simd::mismatch_ci(s1, s2, n);
+        return i == n ? 0 : ci_char_traits<char>::lt(s1[i], s2[i]) ? -1 : 1;
+      }
+#endif
+      return ci_char_traits<char>::compare(s1, s2, n);
+    }
+
+    static constexpr char const *
+    find(char const * p, std::size_t n, char const & c) noexcept
+    {
+#ifdef FALCON_IS_CONSTANT_EVALUATED
+      if (!FALCON_IS_CONSTANT_EVALUATED()) {
+        char const lc = ascii_to_lower(c);
+        if (lc < 'a' || lc > 'z') {
+          return std::char_traits<char>::find(p, n, c);
+        }
+        std::size_t const i = simd::find_char_ci(p, n, lc, 0);
+        return i == simd::npos ? nullptr : p + i;
+      }
+#endif
+      return ci_char_traits<char>::find(p, n, c);
+    }
+
+    static constexpr std::size_t
+    length(char const * p) noexcept
+    { return constexpr_std_char_traits<char>::length(p); }
+  };
+
+  /// Forward iterator on the lowercase characters of a range.
+  template<class Ch>
+  struct ascii_lower_iterator
+  {
+    Ch const * p;
+
+    constexpr Ch operator*() const noexcept
+    { return ascii_to_lower(*p); }
+
+    constexpr ascii_lower_iterator & operator++() noexcept
+    {
+      ++p;
+      return *this;
+    }
+
+    constexpr bool operator!=(ascii_lower_iterator const & other) const noexcept
+    { return p != other.p; }
+  };
+}
+
+
+/// Copy of \a str with 'A'-'Z' converted to 'a'-'z'.
+template<class Ch, std::size_t N, class Tr>
+constexpr basic_string_literal<Ch, N, Tr>
+to_lower(basic_string_literal<Ch, N, Tr> const & str) noexcept
+{ return detail_::transform_literal<Ch, N, Tr>(str, detail_::ascii_to_lower<Ch>); }
+
+/// Copy of \a str with 'a'-'z' converted to 'A'-'Z'.
+template<class Ch, std::size_t N, class Tr>
+constexpr basic_string_literal<Ch, N, Tr>
+to_upper(basic_string_literal<Ch, N, Tr> const & str) noexcept
+{ return detail_::transform_literal<Ch, N, Tr>(str, detail_::ascii_to_upper<Ch>); }
+
+/// Copy of \a str with ci_char_traits.
+template<class Ch, std::size_t N, class Tr>
+constexpr basic_string_literal<Ch, N, ci_char_traits<Ch>>
+to_ci_string_literal(basic_string_literal<Ch, N, Tr> const & str) noexcept
+{ return detail_::core_access::mk_lit<N, ci_char_traits<Ch>>(str.data(), N); }
+
+/// Copy of \a str with std::char_traits.
+template<class Ch, std::size_t N>
+constexpr basic_string_literal<Ch, N>
+to_std_string_literal(basic_string_literal<Ch, N, ci_char_traits<Ch>> const & str) noexcept
+{ return detail_::core_access::mk_lit<N, std::char_traits<Ch>>(str.data(), N); }
+
+namespace make_string_literal_shortcut {
+  /// Creates a basic_string_literal with ci_char_traits.
+  template<class Ch, std::size_t N>
+  constexpr basic_string_literal<Ch, N-1, ci_char_traits<Ch>>
+  ci_lit(Ch const (&arr)[N]) noexcept
+  { return detail_::core_access::mk_lit<N-1, ci_char_traits<Ch>>(arr, N-1); }
+}
+
+} // container
+}
+
+namespace std
+{
+  /// Hash of the lowercase characters, equal strings have the same hash.
+  template<class Ch, size_t N>
+  struct hash<::falcon::container::basic_string_literal<
+    Ch, N, ::falcon::container::ci_char_traits<Ch>>>
+  {
+    constexpr size_t operator()(
+      ::falcon::container::basic_string_literal<
+        Ch, N, ::falcon::container::ci_char_traits<Ch>> const & k
+    ) const noexcept
+    {
+      using iterator = ::falcon::container::detail_::ascii_lower_iterator<Ch>;
+      return ::falcon::fnv1a_hash_fn{}(iterator{k.begin()}, iterator{k.end()});
+    }
+  };
+}
@@ -0,0 +1,292 @@
+/* The MIT License (MIT)
+
+Copyright (c) 2016 jonathan poelen
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/**
+* \author    Jonathan Poelen <jonathan.poelen+falcon@gmail.com>
+* \version   1.0
+* \brief     Character set of a string literal for the find_*_of functions
+*
+* \ingroup strings
+*/
+
+#pragma once
+
+#include <falcon/container/string_literal.hpp>
+
+#include <type_traits>
+#include <cstdint>
+
+
+namespace falcon {
+inline namespace container {
+
+namespace detail_
+{
+  template<class Ch, class Tr> struct runtime_charset;
+}
+
+/**
+ * \brief  Set of the characters of a basic_string_literal, computed at
+ * compile time for a constexpr object.
+ *
+ * Usable with basic_string_literal::find_first_of(),
+ * basic_string_literal::find_last_of(),
+ * basic_string_literal::find_first_not_of() and
+ * basic_string_literal::find_last_not_of().
+ *
+ * With std::char_traits, the membership of a character lower than 256 is
+ * a lookup in a 256-bit table; other characters are compared with the
+ * characters of the set only when the set contains such a character.
+ * With other traits, membership uses \c Traits::eq.
+ *
+ * \tparam Ch  Type of character.
+ * \tparam N  Number of characters in the set.
+ * \tparam Traits  Traits for character type.
+ */
+template<class Ch, std::size_t N, class Traits>
+struct basic_string_literal_charset
+{
+  using value_type = Ch;
+  using traits_type = Traits;
+  using size_type = std::size_t;
+
+  static constexpr size_type npos = size_type(-1);
+
+  constexpr explicit
+  basic_string_literal_charset(
+    basic_string_literal<Ch, N, Traits> const & str) noexcept
+  : str_(str)
+  {
+    for (std::size_t i = 0; i < N; ++i) {
+      auto const u = uint_(str[i]);
+      if (u < 256) {
+        bits_[u / 64] |= std::uint64_t(1) << (u % 64);
+        (u < 128 ? tlo_ : thi_)[u & 0xfu]
+          |= std::uint8_t(1u << ((u >> 4) & 0x7u));
+      }
+      else {
+        has_wide_ = true;
+      }
+    }
+  }
+
+  /// Returns the characters of the set.
+  constexpr basic_string_literal<Ch, N, Traits> const &
+  str() const noexcept
+  { return str_; }
+
+  /// Returns true if \a c is in the set.
+  constexpr bool contains(Ch c) const noexcept
+  {
+    return use_bitmap_
+      ? (uint_(c) < 256
+        ? 0 != ((bits_[uint_(c) / 64] >> (uint_(c) % 64)) & 1u)
+        : has_wide_ && linear_contains_(c))
+      : linear_contains_(c);
+  }
+
+  /**
+   * \brief  Find position of a character of the set.
+   * \param s  String to search into.
+   * \param n  Number of characters of \a s.
+   * \param pos  Index of character to search from (default 0).
+   * \return  Index of first occurrence or npos.
+   */
+  constexpr size_type
+  find_first_of_in(Ch const * s, size_type n, size_type pos = 0) const noexcept
+  { return first_(s, n, pos, false); }
+
+  /**
+   * \brief  Find last position of a character of the set.
+   * \param s  String to search into.
+   * \param n  Number of characters of \a s.
+   * \param pos  Index of character to search back from (default end).
+   * \return  Index of last occurrence or npos.
+   */
+  constexpr size_type
+  find_last_of_in(Ch const * s, size_type n, size_type pos = npos) const noexcept
+  { return last_(s, n, pos, false); }
+
+  /**
+   * \brief  Find position of a character not in the set.
+   * \param s  String to search into.
+   * \param n  Number of characters of \a s.
+   * \param pos  Index of character to search from (default 0).
+   * \return  Index of first occurrence or npos.
+   */
+  constexpr size_type
+  find_first_not_of_in(
+    Ch const * s, size_type n, size_type pos = 0) const noexcept
+  { return first_(s, n, pos, true); }
+
+  /**
+   * \brief  Find last position of a character not in the set.
+   * \param s  String to search into.
+   * \param n  Number of characters of \a s.
+   * \param pos  Index of character to search back from (default end).
+   * \return  Index of last occurrence or npos.
+   */
+  constexpr size_type
+  find_last_not_of_in(
+    Ch const * s, size_type n, size_type pos = npos) const noexcept
+  { return last_(s, n, pos, true); }
+
+private:
+  friend detail_::runtime_charset<Ch, Traits>;
+
+  static constexpr bool use_bitmap_
+    = std::is_same<Traits, std::char_traits<Ch>>::value;
+
+  static constexpr std::size_t uint_(Ch c) noexcept
+  { return std::size_t(static_cast<std::make_unsigned_t<Ch>>(c)); }
+
+  constexpr bool linear_contains_(Ch c) const noexcept
+  {
+    for (std::size_t i = 0; i < N; ++i) {
+      if (traits_type::eq(str_[i], c)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  constexpr size_type
+  first_(Ch const * s, size_type n, size_type pos, bool negate) const noexcept;
+
+  constexpr size_type
+  last_(Ch const * s, size_type n, size_type pos, bool negate) const noexcept;
+
+  basic_string_literal<Ch, N, Traits> str_;
+  std::uint64_t bits_[4] {};
+  // nibble tables (see detail_::simd::nibble_tables)
+  std::uint8_t tlo_[16] {};
+  std::uint8_t thi_[16] {};
+  bool has_wide_ = false;
+};
+
+
+/// Creates a basic_string_literal_charset object, deducing the target type from the types of arguments.
+template<class Ch, std::size_t N, class Tr>
+constexpr basic_string_literal_charset<Ch, N, Tr>
+make_string_literal_charset(basic_string_literal<Ch, N, Tr> const & str) noexcept
+{ return basic_string_literal_charset<Ch, N, Tr>{str}; }
+
+
+// Implementation
+
+namespace detail_
+{
+  /// Non constexpr scan of a charset, selected when the call is not
+  /// constant-evaluated.
+  template<class Ch, class Tr>
+  struct runtime_charset
+  {
+    static constexpr bool enabled = false;
+
+    // never called
+    template<class Charset>
+    static std::size_t first(
+      Charset const &, Ch const *, std::size_t, std::size_t, bool) noexcept
+    { return std::size_t(-1); }
+
+    template<class Charset>
+    static std::size_t last(
+      Charset const &, Ch const *, std::size_t, std::size_t, bool) noexcept
+    { return std::size_t(-1); }
+  };
+
+#ifdef FALCON_STRING_LITERAL_SIMD_SHUFFLE
+  template<>
+  struct runtime_charset<char, std::char_traits<char>>
+  {
+    static constexpr bool enabled = true;
+
+    template<class Charset>
+    static std::size_t first(
+      Charset const & charset, char const * s,
+      std::size_t n, std::size_t pos, bool negate) noexcept
+    {
+      return simd::find_first_of(
+        s, n, pos, {charset.tlo_, charset.thi_}, negate);
+    }
+
+    template<class Charset>
+    static std::size_t last(
+      Charset const & charset, char const * s,
+      std::size_t n, std::size_t pos, bool negate) noexcept
+    {
+      return simd::find_last_of(
+        s, n, pos, {charset.tlo_, charset.thi_}, negate);
+    }
+  };
+#endif
+}
+
+template<class Ch, std::size_t N, class Tr>
+constexpr typename basic_string_literal_charset<Ch, N, Tr>::size_type
+basic_string_literal_charset<Ch, N, Tr>
+::first_(Ch const * s, size_type n, size_type pos, bool negate) const noexcept
+{
+#ifdef FALCON_IS_CONSTANT_EVALUATED
+  if (detail_::runtime_charset<Ch, Tr>::enabled
+    && !FALCON_IS_CONSTANT_EVALUATED()) {
+    return detail_::runtime_charset<Ch, Tr>::first(*this, s, n, pos, negate);
+  }
+#endif
+
+  for (; pos < n; ++pos) {
+    if (contains(s[pos]) != negate) {
+      return pos;
+    }
+  }
+  return npos;
+}
+
+template<class Ch, std::size_t N, class Tr>
+constexpr typename basic_string_literal_charset<Ch, N, Tr>::size_type
+basic_string_literal_charset<Ch, N, Tr>
+::last_(Ch const * s, size_type n, size_type pos, bool negate) const noexcept
+{
+#ifdef FALCON_IS_CONSTANT_EVALUATED
+  if (detail_::runtime_charset<Ch, Tr>::enabled
+    && !FALCON_IS_CONSTANT_EVALUATED()) {
+    return detail_::runtime_charset<Ch, Tr>::last(*this, s, n, pos, negate);
+  }
+#endif
+
+  if (n) {
+    if (--n > pos) {
+      n = pos;
+    }
+    do {
+      if (contains(s[n]) != negate) {
+        return n;
+      }
+    }
+    while (n-- != 0);
+  }
+  return npos;
+}
+
+} // container
+}
@@ -0,0 +1,507 @@
+/* The MIT License (MIT)
+
+Copyright (c) 2016 jonathan poelen
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/**
+* \author    Jonathan Poelen <jonathan.poelen+falcon@gmail.com>
+* \version   1.0
+* \brief     Floating point to basic_string_literal, shortest round-trip representation
+*
+* \ingroup strings
+*/
+
+#pragma once
+
+#include <falcon/container/string_literal.hpp>
+
+#include <type_traits>
+#include <limits>
+#include <cstdint>
+
+#if __cplusplus > 201703L
+# include <version>
+# ifdef __cpp_lib_bit_cast
+#  include <bit>
+# endif
+#endif
+
+
+namespace falcon {
+inline namespace container {
+
+namespace detail_
+{
+  /// Unsigned big integer large enough for the scaled values of a double.
+  struct fp_bignum
+  {
+    static constexpr std::size_t capacity = 40;
+
+    constexpr explicit fp_bignum(std::uint64_t x) noexcept
+    {
+      w[0] = std::uint32_t(x);
+      w[1] = std::uint32_t(x >> 32);
+      n = w[1] ? 2 : w[0] ? 1 : 0;
+    }
+
+    constexpr fp_bignum & mul(std::uint32_t m) noexcept
+    {
+      std::uint64_t carry = 0;
+      for (std::size_t i = 0; i < n; ++i) {
+        carry += std::uint64_t(w[i]) * m;
+        w[i] = std::uint32_t(carry);
+        carry >>= 32;
+      }
+      if (carry) {
+        w[n++] = std::uint32_t(carry);
+      }
+      return *this;
+    }
+
+    constexpr fp_bignum & mul_pow10(unsigned k) noexcept
+    {
+      for (; k >= 9; k -= 9) {
+        mul(1000000000u);
+      }
+      std::uint32_t m = 1;
+      for (; k; --k) {
+        m *= 10;
+      }
+      return mul(m);
+    }
+
+    constexpr fp_bignum & shl(unsigned bits) noexcept
+    {
+      if (!n) {
+        return *this;
+      }
+      std::size_t const words = bits / 32;
+      unsigned const r = bits % 32;
+      std::size_t i = n + words;
+      w[i] = 0;
+      for (; i > words; --i) {
+        std::uint32_t const x = w[i - 1 - words];
+        w[i] |= r ? std::uint32_t(x >> (32 - r)) : 0u;
+        w[i - 1] = std::uint32_t(x << r);
+      }
+      for (; i > 0; --i) {
+        w[i - 1] = 0;
+      }
+      n += words + 1;
+      trim_();
+      return *this;
+    }
+
+    constexpr fp_bignum & add(fp_bignum const & b) noexcept
+    {
+      std::uint64_t carry = 0;
+      std::size_t const m = n < b.n ? b.n : n;
+      for (std::size_t i = 0; i < m; ++i) {
+        carry += std::uint64_t(i < n ? w[i] : 0u) + (i < b.n ? b.w[i] : 0u);
+        w[i] = std::uint32_t(carry);
+        carry >>= 32;
+      }
+      n = m;
+      if (carry) {
+        w[n++] = std::uint32_t(carry);
+      }
+      return *this;
+    }
+
+    /// \pre *this >= b
+    constexpr fp_bignum & sub(fp_bignum const & b) noexcept
+    {
+      std::uint64_t borrow = 0;
+      for (std::size_t i = 0; i < n; ++i) {
+        std::uint64_t const x = std::uint64_t(i < b.n ? b.w[i] : 0u) + borrow;
+        borrow = w[i] < x;
+        w[i] = std::uint32_t(w[i] - x);
+      }
+      trim_();
+      return *this;
+    }
+
+    /// Divides by 10, returns the remainder.
+    constexpr unsigned div10() noexcept
+    {
+      std::uint64_t rem = 0;
+      for (std::size_t i = n; i > 0; --i) {
+        rem = (rem << 32) | w[i - 1];
+        w[i - 1] = std::uint32_t(rem / 10);
+        rem %= 10;
+      }
+      trim_();
+      return unsigned(rem);
+    }
+
+    static constexpr int compare(fp_bignum const & a, fp_bignum const & b) noexcept
+    {
+      if (a.n != b.n) {
+        return a.n < b.n ? -1 : 1;
+      }
+      for (std::size_t i = a.n; i > 0; --i) {
+        if (a.w[i - 1] != b.w[i - 1]) {
+          return a.w[i - 1] < b.w[i - 1] ? -1 : 1;
+        }
+      }
+      return 0;
+    }
+
+    std::uint32_t w[capacity] {};
+    std::size_t n = 0;
+
+  private:
+    constexpr void trim_() noexcept
+    {
+      while (n && !w[n - 1]) {
+        --n;
+      }
+    }
+  };
+
+  template<class T> struct fp_layout;
+
+  template<> struct fp_layout<float>
+  {
+    static constexpr unsigned mantissa_bits = 23;
+    static constexpr int min_exponent = -149;
+  };
+
+  template<> struct fp_layout<double>
+  {
+    static constexpr unsigned mantissa_bits = 52;
+    static constexpr int min_exponent = -1074;
+  };
+
+  /// x = f * 2^e, with e >= min_exponent and f < 2^(mantissa_bits+1)
+  struct fp_decomposed
+  {
+    std::uint64_t f;
+    int e;
+  };
+
+  /// \pre x is finite and positive
+  template<class T>
+  constexpr fp_decomposed fp_decompose(T x) noexcept
+  {
+    using layout = fp_layout<T>;
+    constexpr T hidden = T(std::uint64_t(1) << layout::mantissa_bits);
+    constexpr T two64 = T(18446744073709551616.0);
+
+    // multiplications by powers of 2 are exact
+    int e = 0;
+    while (x >= hidden * 2 * two64) { x /= two64; e += 64; }
+    while (x >= hidden * 2) { x /= 2; ++e; }
+    while (x * two64 < hidden && e - 64 >= layout::min_exponent) {
+      x *= two64;
+      e -= 64;
+    }
+    while (x < hidden && e > layout::min_exponent) { x *= 2; --e; }
+    return {std::uint64_t(x), e};
+  }
+
+  /// floor(p * log10(2)), may be 1 less near an integer
+  constexpr int floor_log10_pow2(int p) noexcept
+  {
+    return p >= 0
+      ? (p * 78913) >> 18
+      : -((-p * 78913 + (1 << 18) - 1) >> 18);
+  }
+
+  /// (x + m) / d reaches the upper bound of the rounding interval
+  constexpr bool fp_high(
+    fp_bignum x, fp_bignum const & m, fp_bignum const & d, bool even) noexcept
+  {
+    int const c = fp_bignum::compare(x.add(m), d);
+    return even ? c >= 0 : c > 0;
+  }
+
+  /// value = 0.digits * 10^k
+  struct fp_digits
+  {
+    char digits[20] {};
+    int ndigits = 0;
+    int k = 0;
+  };
+
+  /// Shortest digits in the rounding interval of f * 2^e, the closest
+  /// when several have the same length (Steele & White, Burger & Dybvig).
+  template<class T>
+  constexpr fp_digits fp_shortest(fp_decomposed v) noexcept
+  {
+    using layout = fp_layout<T>;
+    bool const even = !(v.f & 1u);
+    bool const unequal_gaps = v.f == (std::uint64_t(1) << layout::mantissa_bits)
+                           && v.e > layout::min_exponent;
+
+    // value = r / s, upper bound = (r + mp) / s, lower bound = (r - mm) / s
+    fp_bignum r{v.f};
+    fp_bignum s{1};
+    fp_bignum mp{1};
+    fp_bignum mm{1};
+    unsigned const gap_shift = unequal_gaps ? 2 : 1;
+    r.shl(gap_shift);
+    if (v.e >= 0) {
+      r.shl(unsigned(v.e));
+      s.shl(gap_shift);
+      mp.shl(unsigned(v.e) + gap_shift - 1);
+      mm.shl(unsigned(v.e));
+    }
+    else {
+      s.shl(unsigned(-v.e) + gap_shift);
+      mp.shl(gap_shift - 1);
+    }
+
+    int bitlen = 0;
+    for (std::uint64_t f = v.f; f; f >>= 1) {
+      ++bitlen;
+    }
+    int k = floor_log10_pow2(v.e + bitlen - 1) + 1;
+    if (k >= 0) {
+      s.mul_pow10(unsigned(k));
+    }
+    else {
+      r.mul_pow10(unsigned(-k));
+      mp.mul_pow10(unsigned(-k));
+      mm.mul_pow10(unsigned(-k));
+    }
+
+    while (fp_high(r, mp, s, even)) {
+      s.mul(10);
+      ++k;
+    }
+    while (!fp_high(fp_bignum(r).mul(10), fp_bignum(mp).mul(10), s, even)) {
+      r.mul(10);
+      mp.mul(10);
+      mm.mul(10);
+      --k;
+    }
+
+    fp_digits result;
+    result.k = k;
+    for (;;) {
+      r.mul(10);
+      mp.mul(10);
+      mm.mul(10);
+      char d = 0;
+      while (fp_bignum::compare(r, s) >= 0) {
+        r.sub(s);
+        ++d;
+      }
+
+      int const cmm = fp_bignum::compare(r, mm);
+      bool const low_end = even ? cmm <= 0 : cmm < 0;
+      bool const high_end = fp_high(r, mp, s, even);
+      if (low_end || high_end) {
+        if (high_end) {
+          // both digits are in the interval: the closest, the even one on a tie
+          int const c = low_end ? fp_bignum::compare(fp_bignum(r).shl(1), s) : 1;
+          if (c > 0 || (c == 0 && (d & 1))) {
+            ++d;
+          }
+        }
+        result.digits[result.ndigits++] = char('0' + d);
+        return result;
+      }
+      result.digits[result.ndigits++] = char('0' + d);
+    }
+  }
+
+  struct fp_chars
+  {
+    char data[32] {};
+    std::size_t size = 0;
+
+    constexpr void push(char c) noexcept
+    { data[size++] = c; }
+  };
+
+  template<class T>
+  constexpr bool fp_is_negative(T x) noexcept
+  {
+#ifdef __cpp_lib_bit_cast
+    using uint_t = std::conditional_t<sizeof(T) == 4, std::uint32_t, std::uint64_t>;
+    return std::bit_cast<uint_t>(x) >> (sizeof(T) * 8 - 1);
+#else
+    // -0.0 is not distinguishable from 0.0
+    return x < T(0);
+#endif
+  }
+
+  /// Same output as std::to_chars(first, last, x): the shortest of the
+  /// fixed and scientific notations, the fixed one when they are equal.
+  template<class T>
+  constexpr fp_chars fp_to_chars(T x) noexcept
+  {
+    static_assert(std::is_same<T, float>::value || std::is_same<T, double>::value,
+      "only float and double are supported");
+
+    fp_chars out;
+    if (fp_is_negative(x)) {
+      out.push('-');
+      x = -x;
+    }
+    if (!(x <= x)) {
+      out.push('n'); out.push('a'); out.push('n');
+      return out;
+    }
+    if (x > std::numeric_limits<T>::max()) {
+      out.push('i'); out.push('n'); out.push('f');
+      return out;
+    }
+    if (!(x > T(0))) {
+      out.push('0');
+      return out;
+    }
+
+    fp_decomposed const v = fp_decompose(x);
+    fp_digits const d = fp_shortest<T>(v);
+    int const n = d.ndigits;
+    int const e = d.k - 1;
+    int const abs_e = e < 0 ? -e : e;
+    int const sci_len = n + (n > 1) + 2 + (abs_e >= 100 ? 3 : 2);
+    int const fixed_len
+      = d.k <= 0 ? 2 - d.k + n
+      : d.k >= n ? d.k
+      : n + 1;
+
+    if (fixed_len <= sci_len) {
+      if (d.k <= 0) {
+        out.push('0');
+        out.push('.');
+        for (int i = 0; i < -d.k; ++i) {
+          out.push('0');
+        }
+        for (int i = 0; i < n; ++i) {
+          out.push(d.digits[i]);
+        }
+      }
+      else if (d.k >= n) {
+        // an integer, written with all its digits like std::to_chars
+        // (2^63 gives 9223372036854775808, not 9223372036854776000)
+        fp_bignum u{v.e >= 0 ? v.f : v.f >> -v.e};
+        u.shl(v.e >= 0 ? unsigned(v.e) : 0u);
+        char digits[40] {};
+        int ndigits = 0;
+        do {
+          digits[ndigits++] = char('0' + u.div10());
+        } while (u.n);
+        while (ndigits) {
+          out.push(digits[--ndigits]);
+        }
+      }
+      else {
+        for (int i = 0; i < n; ++i) {
+          if (i == d.k) {
+            out.push('.');
+          }
+          out.push(d.digits[i]);
+        }
+      }
+    }
+    else {
+      out.push(d.digits[0]);
+      if (n > 1) {
+        out.push('.');
+        for (int i = 1; i < n; ++i) {
+          out.push(d.digits[i]);
+        }
+      }
+      out.push('e');
+      out.push(e < 0 ? '-' : '+');
+      if (abs_e >= 100) {
+        out.push(char('0' + abs_e / 100));
+      }
+      out.push(char('0' + abs_e / 10 % 10));
+      out.push(char('0' + abs_e % 10));
+    }
+    return out;
+  }
+
+  template<class Ch, std::size_t N, class Tr>
+  constexpr basic_string_literal<Ch, N, Tr>
+  fp_to_string_literal(fp_chars const & chars) noexcept
+  {
+    Ch buf[N]{};
+    for (std::size_t i = 0; i < N; ++i) {
+      buf[i] = Ch(chars.data[i]);
+    }
+    return core_access::mk_lit<N, Tr>(buf, N);
+  }
+}
+
+
+/**
+ * \brief  Converts \c Constant::value (a float or a double) with the
+ * shortest representation which gives the same value when read back.
+ *
+ * The output is the one of std::to_chars(first, last, value): fixed or
+ * scientific notation, the shortest one. Before C++20, -0.0 gives "0"
+ * and a negative NaN "nan".
+ *
+ * \code
+ * struct timeout { static constexpr double value = 2.5; };
+ * static_assert(to_string_literal_f<timeout>() == lit("2.5"), "");
+ * \endcode
+ */
+template<class Ch, class Constant, class Tr = std::char_traits<Ch>>
+constexpr basic_string_literal<Ch, detail_::fp_to_chars(Constant::value).size, Tr>
+to_basic_string_literal_f() noexcept
+{
+  constexpr auto chars = detail_::fp_to_chars(Constant::value);
+  return detail_::fp_to_string_literal<Ch, chars.size, Tr>(chars);
+}
+
+template<class Constant>
+constexpr string_literal<detail_::fp_to_chars(Constant::value).size>
+to_string_literal_f() noexcept
+{ return to_basic_string_literal_f<char, Constant>(); }
+
+template<class Constant>
+constexpr wstring_literal<detail_::fp_to_chars(Constant::value).size>
+to_wstring_literal_f() noexcept
+{ return to_basic_string_literal_f<wchar_t, Constant>(); }
+
+#if defined(__cpp_nontype_template_args) && __cpp_nontype_template_args >= 201911L
+/// \brief  Converts \a val, a float or a double template argument.
+template<class Ch, auto val, class Tr = std::char_traits<Ch>,
+  class = std::enable_if_t<std::is_floating_point<decltype(val)>::value>>
+constexpr basic_string_literal<Ch, detail_::fp_to_chars(val).size, Tr>
+to_basic_string_literal_f() noexcept
+{
+  constexpr auto chars = detail_::fp_to_chars(val);
+  return detail_::fp_to_string_literal<Ch, chars.size, Tr>(chars);
+}
+
+template<auto val,
+  class = std::enable_if_t<std::is_floating_point<decltype(val)>::value>>
+constexpr string_literal<detail_::fp_to_chars(val).size>
+to_string_literal_f() noexcept
+{ return to_basic_string_literal_f<char, val>(); }
+
+template<auto val,
+  class = std::enable_if_t<std::is_floating_point<decltype(val)>::value>>
+constexpr wstring_literal<detail_::fp_to_chars(val).size>
+to_wstring_literal_f() noexcept
+{ return to_basic_string_literal_f<wchar_t, val>(); }
+#endif
+
+} }
@@ -0,0 +1,302 @@
+/* The MIT License (MIT)
+
+Copyright (c) 2016 jonathan poelen
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/**
+* \author    Jonathan Poelen <jonathan.poelen+falcon@gmail.com>
+* \version   1.0
+* \brief     Format string parsed at compile time into constant segments and slots
+*
+* \ingroup strings
+*/
+
+#pragma once
+
+#include <falcon/container/string_literal.hpp>
+#include <falcon/container/detail/throw_or_abort.hpp>
+#include <falcon/container/string_literal_fwd.hpp>
+
+#include <type_traits>
+#include <string>
+#include <initializer_list>
+
+
+namespace falcon {
+inline namespace container {
+
+namespace detail_
+{
+  [[noreturn]] inline void string_literal_format_unmatched_brace()
+  {
+    throw_or_abort<std::invalid_argument>(
+      "basic_string_literal_format: unmatched '{' or '}', use {{ and }}");
+  }
+
+  [[noreturn]] inline void string_literal_format_bad_argument_count()
+  {
+    throw_or_abort<std::invalid_argument>(
+      "basic_string_literal_format: number of arguments != arity()");
+  }
+
+  /// 0: character, 1: integer, 2: C string, 3: data() and size()
+  template<class Ch, class T>
+  using format_arg_kind = std::integral_constant<int,
+    std::is_same<T, Ch>::value ? 0
+    : std::is_integral<T>::value ? 1
+    : std::is_convertible<T const &, Ch const *>::value ? 2
+    : 3>;
+
+  template<class Ch, class Traits>
+  struct format_arg
+  {
+    template<class T>
+    static constexpr std::size_t size(T const & x) noexcept
+    { return size_(x, format_arg_kind<Ch, T>{}); }
+
+    template<class T>
+    static constexpr Ch * write(Ch * out, T const & x) noexcept
+    { return write_(out, x, format_arg_kind<Ch, T>{}); }
+
+  private:
+    static constexpr std::size_t
+    size_(Ch, std::integral_constant<int, 0>) noexcept
+    { return 1; }
+
+    template<class T>
+    static constexpr std::size_t
+    size_(T const & x, std::integral_constant<int, 1>) noexcept
+    { return integer_size<10>(x); }
+
+    static constexpr std::size_t
+    size_(Ch const * s, std::integral_constant<int, 2>) noexcept
+    { return constexpr_char_traits<Ch, Traits>::length(s); }
+
+    template<class T>
+    static constexpr std::size_t
+    size_(T const & x, std::integral_constant<int, 3>) noexcept
+    { return x.size(); }
+
+    static constexpr Ch *
+    write_(Ch * out, Ch c, std::integral_constant<int, 0>) noexcept
+    {
+      *out = c;
+      return out + 1;
+    }
+
+    template<class T>
+    static constexpr Ch *
+    write_(Ch * out, T const & x, std::integral_constant<int, 1>) noexcept
+    { return write_integer<10>(out, x); }
+
+    static constexpr Ch *
+    write_(Ch * out, Ch const * s, std::integral_constant<int, 2>) noexcept
+    {
+      while (!Traits::eq(*s, Ch())) {
+        *out++ = *s++;
+      }
+      return out;
+    }
+
+    template<class T>
+    static constexpr Ch *
+    write_(Ch * out, T const & x, std::integral_constant<int, 3>) noexcept
+    {
+      Ch const * s = x.data();
+      for (Ch const * e = s + x.size(); s != e; ++s) {
+        *out++ = *s;
+      }
+      return out;
+    }
+  };
+}
+
+/**
+ * \brief  Format string split at compile time, for a constexpr object,
+ * into constant segments and argument slots.
+ *
+ * A slot is written \c {}, \c {{ and \c }} are the characters \c { and
+ * \c }. Any other brace is an error. For \a arity() slots, there are
+ * \a arity() + 1 constant segments (possibly empty) and the formatted
+ * string is <code>segment(0) arg0 segment(1) arg1 ... segment(arity())</code>.
+ *
+ * An argument is a character, an integer (in base 10), a C string or an
+ * object with \c data() and \c size() (basic_string_literal,
+ * std::basic_string, ...).
+ *
+ * \code
+ * constexpr auto request_line = make_string_literal_format(
+ *   lit("GET {} HTTP/1.1\r\n"));
+ * static_assert(request_line.arity() == 1, "");
+ * std::string s = request_line.format(path);
+ * \endcode
+ *
+ * \tparam Ch  Type of character.
+ * \tparam N  Size of the format string.
+ * \tparam Traits  Traits for character type.
+ */
+template<class Ch, std::size_t N, class Traits>
+struct basic_string_literal_format
+{
+  using value_type = Ch;
+  using traits_type = Traits;
+  using size_type = std::size_t;
+
+private:
+  static constexpr std::size_t max_arity = N / 2;
+  using offset_type = detail_::uint_least_for<N + 1>;
+  using arg_ = detail_::format_arg<Ch, Traits>;
+
+public:
+  constexpr explicit
+  basic_string_literal_format(basic_string_literal<Ch, N, Traits> const & fmt)
+  {
+    constexpr auto npos = basic_string_literal<Ch, N, Traits>::npos;
+    Ch const * s = fmt.data();
+    size_type len = 0;
+    size_type pos = 0;
+
+    for (;;) {
+      size_type const open = fmt.find(Ch('{'), pos);
+      size_type const close = fmt.find(Ch('}'), pos);
+
+      if (close < open) {
+        if (!Traits::eq(s[close+1], Ch('}'))) {
+          detail_::string_literal_format_unmatched_brace();
+        }
+        len = append_(len, s, pos, close + 1);
+        pos = close + 2;
+      }
+      else if (open != npos) {
+        len = append_(len, s, pos, open);
+        if (Traits::eq(s[open+1], Ch('{'))) {
+          text_[len++] = Ch('{');
+        }
+        else if (Traits::eq(s[open+1], Ch('}'))) {
+          offsets_[++arity_] = offset_type(len);
+        }
+        else {
+          detail_::string_literal_format_unmatched_brace();
+        }
+        pos = open + 2;
+      }
+      else {
+        len = append_(len, s, pos, N);
+        break;
+      }
+    }
+
+    offsets_[arity_ + 1] = offset_type(len);
+  }
+
+  /// Number of slots.
+  constexpr size_type arity() const noexcept
+  { return arity_; }
+
+  /// Number of constant characters.
+  constexpr size_type constant_size() const noexcept
+  { return offsets_[arity_ + 1]; }
+
+  /// Pointer on the constant segment \a i (not null-terminated).
+  constexpr Ch const * segment_data(size_type i) const noexcept
+  { return text_ + offsets_[i]; }
+
+  /// Size of the constant segment \a i.
+  constexpr size_type segment_size(size_type i) const noexcept
+  { return size_type(offsets_[i + 1] - offsets_[i]); }
+
+  /**
+   * \brief  Size of the formatted string.
+   * \pre  sizeof...(args) == arity()
+   */
+  template<class... Args>
+  constexpr size_type formatted_size(Args const & ... args) const
+  {
+    check_arity_(sizeof...(args));
+    size_type n = constant_size();
+    (void)std::initializer_list<int>{(void(n += arg_::size(args)), 0)...};
+    return n;
+  }
+
+  /**
+   * \brief  Writes the formatted string at \a out, without null character.
+   * \pre  \a out has room for formatted_size(args...) characters
+   * and sizeof...(args) == arity().
+   * \return  \a out + formatted_size(args...).
+   */
+  template<class... Args>
+  constexpr Ch * format_to(Ch * out, Args const & ... args) const
+  {
+    check_arity_(sizeof...(args));
+    size_type i = 0;
+    out = write_segment_(out, i++);
+    (void)std::initializer_list<int>{
+      (void(out = write_segment_(arg_::write(out, args), i++)), 0)...};
+    return out;
+  }
+
+  /// Creates a std::basic_string with the formatted string, with one allocation.
+  template<class... Args>
+  std::basic_string<Ch, Traits> format(Args const & ... args) const
+  {
+    std::basic_string<Ch, Traits> str(formatted_size(args...), Ch());
+    format_to(&str[0], args...);
+    return str;
+  }
+
+private:
+  constexpr size_type append_(
+    size_type len, Ch const * s, size_type first, size_type last) noexcept
+  {
+    for (; first != last; ++first) {
+      text_[len++] = s[first];
+    }
+    return len;
+  }
+
+  constexpr void check_arity_(size_type n) const
+  {
+    if (n != arity_) {
+      detail_::string_literal_format_bad_argument_count();
+    }
+  }
+
+  constexpr Ch * write_segment_(Ch * out, size_type i) const noexcept
+  {
+    for (size_type k = offsets_[i]; k != offsets_[i + 1]; ++k) {
+      *out++ = text_[k];
+    }
+    return out;
+  }
+
+  Ch text_[N + 1] {};
+  offset_type offsets_[max_arity + 2] {};
+  size_type arity_ = 0;
+};
+
+
+/// Creates a basic_string_literal_format, parsing \a fmt.
+template<class Ch, std::size_t N, class Tr>
+constexpr basic_string_literal_format<Ch, N, Tr>
+make_string_literal_format(basic_string_literal<Ch, N, Tr> const & fmt)
+{ return basic_string_literal_format<Ch, N, Tr>{fmt}; }
+
+} }
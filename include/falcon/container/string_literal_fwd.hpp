@@ -40,6 +40,30 @@ inline namespace container {
 template<class Ch, std::size_t N, class Traits = std::char_traits<Ch>>
 struct basic_string_literal;
 
+template<class Ch, std::size_t N, class Traits = std::char_traits<Ch>>
+struct basic_string_literal_searcher;
+
+template<class Ch, std::size_t N, class Traits = std::char_traits<Ch>>
+struct basic_string_literal_charset;
+
+template<class Ch, std::size_t N, class Traits = std::char_traits<Ch>>
+struct basic_hashed_string_literal;
+
+template<class Ch, std::size_t N, class Traits = std::char_traits<Ch>>
+struct basic_string_literal_format;
+
+template<class Ch, std::size_t N, std::size_t Count, class Traits = std::char_traits<Ch>>
+class basic_string_literal_pool;
+
+template<class Ch, std::size_t N, class Traits = std::char_traits<Ch>>
+struct basic_literal_ref;
+
+template<class Ch, std::size_t N, std::size_t Align, class Traits = std::char_traits<Ch>>
+struct basic_aligned_string_literal;
+
+template<class Ch>
+struct ci_char_traits;
+
 template<std::size_t n> using string_literal    = basic_string_literal<char, n>;
 template<std::size_t n> using wstring_literal   = basic_string_literal<wchar_t, n>;
 template<std::size_t n> using u16string_literal = basic_string_literal<char16_t, n>;
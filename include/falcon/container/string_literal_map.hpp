@@ -0,0 +1,401 @@
+/* The MIT License (MIT)
+
+Copyright (c) 2016 jonathan poelen
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/**
+* \author    Jonathan Poelen <jonathan.poelen+falcon@gmail.com>
+* \version   1.0
+* \brief     Set and map of string literals with a minimal perfect hash
+*
+* \ingroup strings
+*/
+
+#pragma once
+
+#include <falcon/container/string_literal.hpp>
+#include <falcon/container/detail/throw_or_abort.hpp>
+#include <falcon/functional/fnv.hpp>
+#include <falcon/cxx/string_view.hpp>
+
+#include <type_traits>
+#include <utility> // std::pair
+#include <cstdint>
+
+
+namespace falcon {
+inline namespace container {
+
+namespace detail_
+{
+  /// FNV-1a 64 bits whose offset basis depends on \a seed.
+  template<class Ch>
+  constexpr std::uint64_t
+  seeded_fnv1a(std::uint64_t seed, Ch const * s, std::size_t n) noexcept
+  {
+    std::uint64_t h = fnv_64_offset_basis ^ (seed * 0x9e3779b97f4a7c15u);
+    for (Ch const * e = s + n; s != e; ++s) {
+      h ^= std::uint64_t(*s);
+      h *= fnv_64_prime;
+    }
+    return h;
+  }
+
+  [[noreturn]] inline void string_literal_set_has_duplicate_keys()
+  {
+    throw_or_abort<std::invalid_argument>(
+      "basic_string_literal_set: duplicate keys");
+  }
+
+  [[noreturn]] inline void string_literal_set_perfect_hash_not_found()
+  {
+    throw_or_abort<std::runtime_error>(
+      "basic_string_literal_set: no perfect hash");
+  }
+}
+
+/**
+ * \brief  Set of string literals with a minimal perfect hash, built at
+ * compile time for a constexpr object.
+ *
+ * The constructor searches a seed of FNV-1a and a displacement per bucket
+ * (hash and displace) such that each key has its own slot. A lookup costs
+ * one hash, one probe and one comparison. The characters of the keys are
+ * stored contiguously.
+ *
+ * Characters are hashed by value, \c Traits must be std::char_traits.
+ * Duplicate keys are an error.
+ *
+ * \tparam Ch  Type of character.
+ * \tparam Traits  Traits for character type.
+ * \tparam NKeys  Number of keys.
+ * \tparam Total  Sum of the sizes of the keys.
+ */
+template<class Ch, class Traits, std::size_t NKeys, std::size_t Total>
+struct basic_string_literal_set
+{
+  static_assert(std::is_same<Traits, std::char_traits<Ch>>::value,
+    "characters are hashed by value");
+
+  using value_type = Ch;
+  using traits_type = Traits;
+  using size_type = std::size_t;
+
+  static constexpr size_type npos = size_type(-1);
+
+private:
+  using index_type = detail_::uint_least_for<NKeys + 1>;
+  using offset_type = detail_::uint_least_for<Total + 1>;
+
+public:
+  /**
+   * \throw std::invalid_argument  two keys are equal.
+   * \throw std::runtime_error  no perfect hash is found.
+   */
+  template<std::size_t... Ns>
+  constexpr explicit
+  basic_string_literal_set(
+    basic_string_literal<Ch, Ns, Traits> const & ... strs)
+  {
+    static_assert(sizeof...(Ns) == NKeys, "bad number of keys");
+    static_assert(detail_::sum_sizes<Ns...>() == Total, "bad total size");
+    Ch const * strings[NKeys ? NKeys : 1] {strs.data()...};
+    std::size_t const sizes[NKeys ? NKeys : 1] {strs.size()...};
+
+    std::size_t offset = 0;
+    for (std::size_t i = 0; i < NKeys; ++i) {
+      offsets_[i] = offset_type(offset);
+      sizes_[i] = offset_type(sizes[i]);
+      detail_::acpy(chars_ + offset, strings[i], sizes[i]);
+      offset += sizes[i];
+    }
+
+    for (std::size_t i = 0; i < NKeys; ++i) {
+      for (std::size_t j = i + 1; j < NKeys; ++j) {
+        if (equal_key_(j, chars_ + offsets_[i], sizes_[i])) {
+          detail_::string_literal_set_has_duplicate_keys();
+        }
+      }
+    }
+
+    for (std::uint64_t seed = 0; seed < 256; ++seed) {
+      if (try_seed_(seed)) {
+        return;
+      }
+    }
+    detail_::string_literal_set_perfect_hash_not_found();
+  }
+
+  /// Number of keys.
+  constexpr size_type size() const noexcept { return NKeys; }
+
+  /// Returns the index of \a s in the list of keys or npos.
+  constexpr size_type index_of(Ch const * s, size_type n) const noexcept
+  {
+    if (!NKeys) {
+      return npos;
+    }
+    std::size_t const i = slots_[slot_(detail_::seeded_fnv1a(seed_, s, n))];
+    return equal_key_(i, s, n) ? i : npos;
+  }
+
+#ifdef FALCON_STD_STRING_VIEW
+  /// Returns the index of \a str in the list of keys or npos.
+  constexpr size_type
+  index_of(FALCON_STD_STRING_VIEW<Ch, Traits> str) const noexcept
+  { return index_of(str.data(), str.size()); }
+#endif
+
+  /// Returns the index of \a str in the list of keys or npos.
+  template<std::size_t N>
+  constexpr size_type
+  index_of(basic_string_literal<Ch, N, Traits> const & str) const noexcept
+  { return index_of(str.data(), str.size()); }
+
+  /// Returns true if \a s is a key.
+  constexpr bool contains(Ch const * s, size_type n) const noexcept
+  { return index_of(s, n) != npos; }
+
+#ifdef FALCON_STD_STRING_VIEW
+  /// Returns true if \a str is a key.
+  constexpr bool
+  contains(FALCON_STD_STRING_VIEW<Ch, Traits> str) const noexcept
+  { return index_of(str.data(), str.size()) != npos; }
+#endif
+
+  /// Returns true if \a str is a key.
+  template<std::size_t N>
+  constexpr bool
+  contains(basic_string_literal<Ch, N, Traits> const & str) const noexcept
+  { return index_of(str.data(), str.size()) != npos; }
+
+  /// Returns a pointer on the characters of the key \a i.
+  constexpr Ch const * key_data(size_type i) const noexcept
+  { return chars_ + offsets_[i]; }
+
+  /// Returns the size of the key \a i.
+  constexpr size_type key_size(size_type i) const noexcept
+  { return sizes_[i]; }
+
+private:
+  static constexpr std::size_t n_ = NKeys ? NKeys : 1;
+
+  // slot = (f1 + d0 * f2 + d1) % NKeys
+  constexpr std::size_t
+  slot_(std::uint64_t h, std::size_t d0, std::size_t d1) const noexcept
+  {
+    return std::size_t(
+      ((h & 0xffffffffu) % n_ + d0 * ((h >> 32) % n_) + d1) % n_);
+  }
+
+  constexpr std::size_t bucket_(std::uint64_t h) const noexcept
+  { return std::size_t(((h >> 32) ^ (h >> 11)) % n_); }
+
+  constexpr std::size_t slot_(std::uint64_t h) const noexcept
+  {
+    std::size_t const b = bucket_(h);
+    return slot_(h, displacements_[b][0], displacements_[b][1]);
+  }
+
+  constexpr bool
+  equal_key_(std::size_t i, Ch const * s, std::size_t n) const noexcept
+  {
+    return sizes_[i] == n && 0 == detail_::constexpr_char_traits<Ch, Traits>
+      ::compare(chars_ + offsets_[i], s, n);
+  }
+
+  constexpr bool try_seed_(std::uint64_t seed) noexcept;
+
+  std::uint64_t seed_ = 0;
+  index_type displacements_[n_][2] {};
+  // index of the key of a slot
+  index_type slots_[n_] {};
+  offset_type offsets_[n_] {};
+  offset_type sizes_[n_] {};
+  Ch chars_[Total ? Total : 1] {};
+};
+
+
+/**
+ * \brief  Map whose keys are string literals, with a minimal perfect hash
+ * built at compile time for a constexpr object.
+ *
+ * \see basic_string_literal_set
+ *
+ * \tparam Ch  Type of character.
+ * \tparam Traits  Traits for character type.
+ * \tparam V  Type of value, must be a literal type.
+ * \tparam NKeys  Number of keys.
+ * \tparam Total  Sum of the sizes of the keys.
+ */
+template<class Ch, class Traits, class V, std::size_t NKeys, std::size_t Total>
+struct basic_string_literal_map
+{
+  using key_set = basic_string_literal_set<Ch, Traits, NKeys, Total>;
+  using mapped_type = V;
+  using size_type = std::size_t;
+
+  template<std::size_t... Ns>
+  constexpr explicit
+  basic_string_literal_map(
+    std::pair<basic_string_literal<Ch, Ns, Traits>, V> const & ... entries)
+  : keys_(entries.first...)
+  , values_{entries.second...}
+  {}
+
+  /// Number of keys.
+  constexpr size_type size() const noexcept { return NKeys; }
+
+  /// Returns the set of keys.
+  constexpr key_set const & keys() const noexcept { return keys_; }
+
+  /// Returns the value of the key \a i (see key_set::index_of()).
+  constexpr V const & value(size_type i) const noexcept
+  { return values_[i]; }
+
+  /// Returns the value associated to \a s or nullptr.
+  constexpr V const * find(Ch const * s, size_type n) const noexcept
+  { return ptr_(keys_.index_of(s, n)); }
+
+#ifdef FALCON_STD_STRING_VIEW
+  /// Returns the value associated to \a str or nullptr.
+  constexpr V const *
+  find(FALCON_STD_STRING_VIEW<Ch, Traits> str) const noexcept
+  { return ptr_(keys_.index_of(str.data(), str.size())); }
+#endif
+
+  /// Returns the value associated to \a str or nullptr.
+  template<std::size_t N>
+  constexpr V const *
+  find(basic_string_literal<Ch, N, Traits> const & str) const noexcept
+  { return ptr_(keys_.index_of(str.data(), str.size())); }
+
+private:
+  constexpr V const * ptr_(size_type i) const noexcept
+  { return i == key_set::npos ? nullptr : &values_[i]; }
+
+  key_set keys_;
+  V values_[NKeys ? NKeys : 1];
+};
+
+
+template<class Ch, class Tr, std::size_t... Ns>
+using string_literal_set_for = basic_string_literal_set<
+  Ch, Tr, sizeof...(Ns), detail_::sum_sizes<Ns...>()>;
+
+template<class Ch, class Tr, class V, std::size_t... Ns>
+using string_literal_map_for = basic_string_literal_map<
+  Ch, Tr, V, sizeof...(Ns), detail_::sum_sizes<Ns...>()>;
+
+/// Creates a basic_string_literal_set object, deducing the target type from the types of arguments.
+template<class Ch, class Tr, std::size_t... Ns>
+constexpr string_literal_set_for<Ch, Tr, Ns...>
+make_string_literal_set(
+  basic_string_literal<Ch, Ns, Tr> const & ... strs)
+{ return string_literal_set_for<Ch, Tr, Ns...>{strs...}; }
+
+/// Creates a basic_string_literal_map object, deducing the target type from the types of arguments.
+template<class Ch, class Tr, class V, std::size_t... Ns>
+constexpr string_literal_map_for<Ch, Tr, V, Ns...>
+make_string_literal_map(
+  std::pair<basic_string_literal<Ch, Ns, Tr>, V> const & ... entries)
+{ return string_literal_map_for<Ch, Tr, V, Ns...>{entries...}; }
+
+
+// Implementation
+
+template<class Ch, class Tr, std::size_t NKeys, std::size_t Total>
+constexpr bool
+basic_string_literal_set<Ch, Tr, NKeys, Total>
+::try_seed_(std::uint64_t seed) noexcept
+{
+  std::uint64_t hashes[n_] {};
+  std::size_t bucket_sizes[n_] {};
+  bool used[n_] {};
+  std::size_t max_bucket_size = 0;
+
+  for (std::size_t i = 0; i < NKeys; ++i) {
+    hashes[i] = detail_::seeded_fnv1a(seed, chars_ + offsets_[i], sizes_[i]);
+    auto & sz = bucket_sizes[bucket_(hashes[i])];
+    if (++sz > max_bucket_size) {
+      max_bucket_size = sz;
+    }
+  }
+
+  // largest buckets first
+  for (std::size_t k = max_bucket_size; k > 0; --k) {
+    for (std::size_t b = 0; b < NKeys; ++b) {
+      if (bucket_sizes[b] != k) {
+        continue;
+      }
+
+      std::size_t keys[n_] {};
+      std::size_t nkeys = 0;
+      for (std::size_t i = 0; i < NKeys; ++i) {
+        if (bucket_(hashes[i]) == b) {
+          keys[nkeys++] = i;
+        }
+      }
+
+      bool found = false;
+      for (std::size_t d0 = 0; d0 < NKeys && !found; ++d0) {
+        for (std::size_t d1 = 0; d1 < NKeys && !found; ++d1) {
+          std::size_t j = 0;
+          for (; j < nkeys; ++j) {
+            std::size_t const slot = slot_(hashes[keys[j]], d0, d1);
+            if (used[slot]) {
+              break;
+            }
+            used[slot] = true;
+          }
+          if (j == nkeys) {
+            found = true;
+            displacements_[b][0] = index_type(d0);
+            displacements_[b][1] = index_type(d1);
+            for (j = 0; j < nkeys; ++j) {
+              slots_[slot_(hashes[keys[j]], d0, d1)] = index_type(keys[j]);
+            }
+          }
+          else {
+            while (j-- > 0) {
+              used[slot_(hashes[keys[j]], d0, d1)] = false;
+            }
+          }
+        }
+      }
+
+      if (!found) {
+        for (std::size_t i = 0; i < n_; ++i) {
+          displacements_[i][0] = 0;
+          displacements_[i][1] = 0;
+          slots_[i] = 0;
+        }
+        return false;
+      }
+    }
+  }
+
+  seed_ = seed;
+  return true;
+}
+
+} // container
+}
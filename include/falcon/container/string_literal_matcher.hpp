@@ -0,0 +1,325 @@
+/* The MIT License (MIT)
+
+Copyright (c) 2016 jonathan poelen
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/**
+* \author    Jonathan Poelen <jonathan.poelen+falcon@gmail.com>
+* \version   1.0
+* \brief     Aho-Corasick automaton of several string literals
+*
+* \ingroup strings
+*/
+
+#pragma once
+
+#include <falcon/container/string_literal.hpp>
+#include <falcon/cxx/string_view.hpp>
+
+#include <type_traits>
+#include <cstdint>
+
+
+namespace falcon {
+inline namespace container {
+
+namespace detail_
+{
+  constexpr std::size_t matcher_alphabet_size(std::size_t char_size)
+  { return char_size == 1 ? 256 : std::size_t(-1); }
+}
+
+/// Result of basic_string_literal_matcher::find().
+struct literal_match
+{
+  static constexpr std::size_t npos = std::size_t(-1);
+
+  /// Index of the literal in the list of the matcher, or npos.
+  std::size_t index = npos;
+  /// Position of the first character of the match, or npos.
+  std::size_t pos = npos;
+
+  constexpr explicit operator bool () const noexcept
+  { return index != npos; }
+};
+
+/**
+ * \brief  Aho-Corasick automaton of a list of basic_string_literal, built
+ * at compile time for a constexpr object.
+ *
+ * The transitions are a flat table indexed by state and character class,
+ * where only the characters present in the literals have a class.
+ * Characters are compared by value, \c Traits must be std::char_traits.
+ *
+ * \tparam Ch  Type of character.
+ * \tparam Traits  Traits for character type.
+ * \tparam NLit  Number of literals.
+ * \tparam Total  Sum of the sizes of the literals.
+ */
+template<class Ch, class Traits, std::size_t NLit, std::size_t Total>
+struct basic_string_literal_matcher
+{
+  static_assert(std::is_same<Traits, std::char_traits<Ch>>::value,
+    "characters are compared by value");
+
+  using value_type = Ch;
+  using traits_type = Traits;
+  using size_type = std::size_t;
+
+  static constexpr size_type npos = size_type(-1);
+
+private:
+  static constexpr std::size_t max_states = Total + 1;
+  static constexpr std::size_t max_classes = 1 + std::min(Total,
+    detail_::matcher_alphabet_size(sizeof(Ch)));
+
+  using state_type = detail_::uint_least_for<max_states>;
+  using class_type = detail_::uint_least_for<max_classes>;
+  using index_type = detail_::uint_least_for<NLit + 1>;
+
+public:
+  template<std::size_t... Ns>
+  constexpr explicit
+  basic_string_literal_matcher(
+    basic_string_literal<Ch, Ns, Traits> const & ... strs) noexcept
+  {
+    static_assert(sizeof...(Ns) == NLit, "bad number of literals");
+    static_assert(detail_::sum_sizes<Ns...>() == Total, "bad total size");
+    Ch const * strings[NLit ? NLit : 1] {strs.data()...};
+    std::size_t const sizes[NLit ? NLit : 1] {strs.size()...};
+
+    // character classes
+    for (std::size_t i = 0; i < NLit; ++i) {
+      for (std::size_t j = 0; j < sizes[i]; ++j) {
+        add_class_(strings[i][j]);
+      }
+    }
+
+    // trie, a transition to 0 means no child
+    for (std::size_t i = 0; i < NLit; ++i) {
+      std::size_t state = 0;
+      for (std::size_t j = 0; j < sizes[i]; ++j) {
+        auto & next = delta_[state * nclasses_ + class_of(strings[i][j])];
+        if (!next) {
+          next = state_type(nstates_++);
+        }
+        state = next;
+      }
+      if (!out_[state]) {
+        out_[state] = index_type(i + 1);
+      }
+      lens_[i] = sizes[i];
+    }
+
+    // failure links, completes the transitions (breadth-first order)
+    state_type fail[max_states] {};
+    state_type queue[max_states] {};
+    std::size_t qfirst = 0;
+    std::size_t qlast = 0;
+    queue[qlast++] = 0;
+    while (qfirst != qlast) {
+      std::size_t const state = queue[qfirst++];
+      for (std::size_t c = 0; c < nclasses_; ++c) {
+        auto & next = delta_[state * nclasses_ + c];
+        auto const fallback = delta_[fail[state] * nclasses_ + c];
+        if (next) {
+          fail[next] = state ? fallback : state_type(0);
+          link_[next] = out_[fail[next]] ? fail[next] : link_[fail[next]];
+          queue[qlast++] = next;
+        }
+        else {
+          next = state ? fallback : state_type(0);
+        }
+      }
+    }
+  }
+
+  /// Number of literals.
+  constexpr size_type size() const noexcept { return NLit; }
+
+  /// Number of states of the automaton.
+  constexpr size_type states() const noexcept { return nstates_; }
+
+  /// Number of character classes, including the class of the characters
+  /// that are not in the literals.
+  constexpr size_type classes() const noexcept { return nclasses_; }
+
+  /// Class of a character, 0 when it is not in any literal.
+  constexpr size_type class_of(Ch c) const noexcept
+  {
+    auto const u = uint_(c);
+    if (u < 256) {
+      return classes_[u];
+    }
+    for (std::size_t i = 0; i < nwide_; ++i) {
+      if (wide_[i] == c) {
+        return wide_classes_[i];
+      }
+    }
+    return 0;
+  }
+
+  /**
+   * \brief  Find the first literal that ends in a string.
+   * \param s  String to search into.
+   * \param n  Number of characters of \a s.
+   * \param pos  Index of character to search from (default 0).
+   *
+   * Returns the index and the position of the literal whose end is the
+   * closest to \a pos. When several literals end at the same position,
+   * the longest one is returned. An empty literal matches at \a pos.
+   */
+  constexpr literal_match
+  find(Ch const * s, size_type n, size_type pos = 0) const noexcept;
+
+#ifdef FALCON_STD_STRING_VIEW
+  /// Find the first literal that ends in \a str.
+  constexpr literal_match
+  find(FALCON_STD_STRING_VIEW<Ch, Traits> str, size_type pos = 0) const noexcept
+  { return find(str.data(), str.size(), pos); }
+#endif
+
+  /// Find the first literal that ends in \a str.
+  template<std::size_t N>
+  constexpr literal_match
+  find(
+    basic_string_literal<Ch, N, Traits> const & str
+  , size_type pos = 0) const noexcept
+  { return find(str.data(), str.size(), pos); }
+
+  /**
+   * \brief  Calls \c f(index, pos) for each match in a string.
+   * \param s  String to search into.
+   * \param n  Number of characters of \a s.
+   * \param f  Function called with the index and the position of a literal.
+   *
+   * Matches are reported by position of end, the longest first.
+   * Empty literals are not reported.
+   */
+  template<class F>
+  constexpr void for_each_match(Ch const * s, size_type n, F && f) const;
+
+#ifdef FALCON_STD_STRING_VIEW
+  /// Calls \c f(index, pos) for each match in \a str.
+  template<class F>
+  constexpr void
+  for_each_match(FALCON_STD_STRING_VIEW<Ch, Traits> str, F && f) const
+  { for_each_match(str.data(), str.size(), f); }
+#endif
+
+private:
+  static constexpr std::size_t uint_(Ch c) noexcept
+  { return std::size_t(static_cast<std::make_unsigned_t<Ch>>(c)); }
+
+  constexpr void add_class_(Ch c) noexcept
+  {
+    if (!class_of(c)) {
+      auto const u = uint_(c);
+      if (u < 256) {
+        classes_[u] = class_type(nclasses_++);
+      }
+      else {
+        wide_[nwide_] = c;
+        wide_classes_[nwide_++] = class_type(nclasses_++);
+      }
+    }
+  }
+
+  constexpr size_type next_(size_type state, Ch c) const noexcept
+  { return delta_[state * nclasses_ + class_of(c)]; }
+
+  // 0 is the class of the characters that are not in a literal
+  std::size_t nclasses_ = 1;
+  std::size_t nstates_ = 1;
+  std::size_t nwide_ = 0;
+  class_type classes_[256] {};
+  Ch wide_[Total ? Total : 1] {};
+  class_type wide_classes_[Total ? Total : 1] {};
+  // delta_[state * nclasses_ + class]
+  state_type delta_[max_states * max_classes] {};
+  // index + 1 of the literal that ends on a state
+  index_type out_[max_states] {};
+  // closest state with an output in the chain of failure links
+  state_type link_[max_states] {};
+  std::size_t lens_[NLit ? NLit : 1] {};
+};
+
+
+template<class Ch, class Tr, std::size_t... Ns>
+using string_literal_matcher_for = basic_string_literal_matcher<
+  Ch, Tr, sizeof...(Ns), detail_::sum_sizes<Ns...>()>;
+
+/// Creates a basic_string_literal_matcher object, deducing the target type from the types of arguments.
+template<class Ch, class Tr, std::size_t... Ns>
+constexpr string_literal_matcher_for<Ch, Tr, Ns...>
+make_string_literal_matcher(
+  basic_string_literal<Ch, Ns, Tr> const & ... strs) noexcept
+{ return string_literal_matcher_for<Ch, Tr, Ns...>{strs...}; }
+
+
+// Implementation
+
+template<class Ch, class Tr, std::size_t NLit, std::size_t Total>
+constexpr literal_match
+basic_string_literal_matcher<Ch, Tr, NLit, Total>
+::find(Ch const * s, size_type n, size_type pos) const noexcept
+{
+  literal_match m;
+  if (pos <= n) {
+    if (out_[0]) {
+      m.index = out_[0] - 1u;
+      m.pos = pos;
+      return m;
+    }
+    size_type state = 0;
+    for (; pos < n; ++pos) {
+      state = next_(state, s[pos]);
+      size_type const found = out_[state] ? state : link_[state];
+      if (found) {
+        m.index = out_[found] - 1u;
+        m.pos = pos + 1 - lens_[m.index];
+        break;
+      }
+    }
+  }
+  return m;
+}
+
+template<class Ch, class Tr, std::size_t NLit, std::size_t Total>
+template<class F>
+constexpr void
+basic_string_literal_matcher<Ch, Tr, NLit, Total>
+::for_each_match(Ch const * s, size_type n, F && f) const
+{
+  size_type state = 0;
+  for (size_type pos = 0; pos < n; ++pos) {
+    state = next_(state, s[pos]);
+    for (size_type found = out_[state] ? state : link_[state];
+      found; found = link_[found]
+    ) {
+      size_type const index = out_[found] - 1u;
+      f(index, pos + 1 - lens_[index]);
+    }
+  }
+}
+
+} // container
+}
@@ -0,0 +1,340 @@
+/* The MIT License (MIT)
+
+Copyright (c) 2016 jonathan poelen
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/**
+* \author    Jonathan Poelen <jonathan.poelen+falcon@gmail.com>
+* \version   1.0
+* \brief     Integer parsing of basic_string_literal and string_view
+*
+* \ingroup strings
+*/
+
+#pragma once
+
+#include <falcon/container/string_literal.hpp>
+#include <falcon/container/detail/throw_or_abort.hpp>
+#include <falcon/cxx/is_constant_evaluated.hpp>
+#include <falcon/cxx/string_view.hpp>
+
+#include <system_error>
+#include <type_traits>
+#include <limits>
+#include <cstdint>
+#include <cstring>
+
+
+namespace falcon {
+inline namespace container {
+
+namespace detail_
+{
+  [[noreturn]] inline void parse_integer_invalid_argument()
+  {
+    throw_or_abort<std::invalid_argument>("parse_result: not an integer");
+  }
+
+  [[noreturn]] inline void parse_integer_out_of_range()
+  {
+    throw_or_abort<std::out_of_range>("parse_result: integer out of range");
+  }
+}
+
+/**
+ * \brief  Result of parse_int(), parse_uint() and parse_hex(): an integer
+ * or an error.
+ *
+ * value() is not a constant expression on error, an invalid literal
+ * fails to compile:
+ * \code
+ * constexpr int port = parse_int(lit("8080")).value();
+ * \endcode
+ */
+template<class T>
+class parse_result
+{
+public:
+  using value_type = T;
+
+  constexpr parse_result(T x) noexcept
+  : value_(x)
+  , ec_()
+  , pos_(0)
+  {}
+
+  constexpr parse_result(std::errc ec, std::size_t pos) noexcept
+  : value_()
+  , ec_(ec)
+  , pos_(pos)
+  {}
+
+  constexpr bool has_value() const noexcept
+  { return ec_ == std::errc(); }
+
+  constexpr explicit operator bool() const noexcept
+  { return has_value(); }
+
+  /// std::errc() on success, otherwise std::errc::invalid_argument
+  /// or std::errc::result_out_of_range.
+  constexpr std::errc error() const noexcept
+  { return ec_; }
+
+  /// Index of the first invalid character (the size for an empty string
+  /// or a sign without digit), 0 on success or out of range.
+  constexpr std::size_t error_position() const noexcept
+  { return pos_; }
+
+  /// \exception std::invalid_argument or std::out_of_range on error
+  constexpr T value() const
+  {
+    if (ec_ == std::errc::invalid_argument) {
+      detail_::parse_integer_invalid_argument();
+    }
+    if (ec_ == std::errc::result_out_of_range) {
+      detail_::parse_integer_out_of_range();
+    }
+    return value_;
+  }
+
+  constexpr T value_or(T x) const noexcept
+  { return has_value() ? value_ : x; }
+
+  /// \pre has_value()
+  constexpr T operator*() const noexcept
+  { return value_; }
+
+private:
+  T value_;
+  std::errc ec_;
+  std::size_t pos_;
+};
+
+
+namespace detail_
+{
+  /// value of the digit \a c, \a Base when \a c is not a digit
+  template<unsigned Base, class Ch>
+  constexpr unsigned parse_digit(Ch c) noexcept
+  {
+    return (c >= Ch('0') && c <= Ch('9')) ? unsigned(c - Ch('0'))
+      : Base <= 10 ? Base
+      : (c >= Ch('a') && c <= Ch('f')) ? unsigned(c - Ch('a')) + 10u
+      : (c >= Ch('A') && c <= Ch('F')) ? unsigned(c - Ch('A')) + 10u
+      : Base;
+  }
+
+  // a word read with memcpy has the first character in the low byte
+  // only on little endian
+#if (defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__) \
+  || defined(_MSC_VER)
+  template<class Ch>
+  struct parse_swar_enabled
+  : std::integral_constant<bool, sizeof(Ch) == 1 && std::is_integral<Ch>::value>
+  {};
+#else
+  template<class Ch>
+  struct parse_swar_enabled : std::false_type
+  {};
+#endif
+
+  inline bool swar_is_8digits(std::uint64_t x) noexcept
+  {
+    return ((x & 0xF0F0F0F0F0F0F0F0u)
+         | (((x + 0x0606060606060606u) & 0xF0F0F0F0F0F0F0F0u) >> 4))
+      == 0x3333333333333333u;
+  }
+
+  /// value of 8 decimal digits, the first in the low byte
+  inline std::uint32_t swar_parse_8digits(std::uint64_t x) noexcept
+  {
+    x -= 0x3030303030303030u;
+    x = (x * 10) + (x >> 8);
+    x = (((x & 0x000000FF000000FFu) * (100 + (1000000ull << 32)))
+       + (((x >> 16) & 0x000000FF000000FFu) * (1 + (10000ull << 32)))) >> 32;
+    return std::uint32_t(x);
+  }
+
+  /// Consumes the blocks of 8 digits, returns false on overflow.
+  template<class Ch>
+  inline bool swar_parse_digits10(
+    Ch const * s, std::size_t n, std::size_t & i,
+    unsigned long long & acc, unsigned long long max) noexcept
+  {
+    for (; n - i >= 8; i += 8) {
+      std::uint64_t w;
+      std::memcpy(&w, s + i, 8);
+      if (!swar_is_8digits(w)) {
+        break;
+      }
+      std::uint32_t const chunk = swar_parse_8digits(w);
+      if (chunk > max || acc > (max - chunk) / 100000000u) {
+        return false;
+      }
+      acc = acc * 100000000u + chunk;
+    }
+    return true;
+  }
+
+  /// Digits of s[pos, n) in base 10 or 16, at most \a max.
+  template<unsigned Base, class Ch>
+  constexpr parse_result<unsigned long long> parse_digits(
+    Ch const * s, std::size_t n, std::size_t pos, unsigned long long max) noexcept
+  {
+    if (pos == n) {
+      return {std::errc::invalid_argument, n};
+    }
+
+    unsigned long long acc = 0;
+    bool overflow = false;
+    std::size_t i = pos;
+
+#ifdef FALCON_IS_CONSTANT_EVALUATED
+    if (parse_swar_enabled<Ch>::value && Base == 10
+      && !FALCON_IS_CONSTANT_EVALUATED()) {
+      overflow = !swar_parse_digits10(s, n, i, acc, max);
+    }
+#endif
+
+    unsigned long long const limit = max / Base;
+    unsigned const limit_digit = unsigned(max % Base);
+
+    // no overflow with less digits than max
+    std::size_t safe_digits = 0;
+    for (unsigned long long m = limit; m; m /= Base) {
+      ++safe_digits;
+    }
+    if (!overflow && acc == 0 && n - i <= safe_digits) {
+      for (; i < n; ++i) {
+        unsigned const d = parse_digit<Base>(s[i]);
+        if (d >= Base) {
+          return {std::errc::invalid_argument, i};
+        }
+        acc = acc * Base + d;
+      }
+      return acc;
+    }
+
+    for (; i < n; ++i) {
+      unsigned const d = parse_digit<Base>(s[i]);
+      if (d >= Base) {
+        return {std::errc::invalid_argument, i};
+      }
+      if (acc > limit || (acc == limit && d > limit_digit)) {
+        overflow = true;
+      }
+      else {
+        acc = acc * Base + d;
+      }
+    }
+
+    if (overflow) {
+      return {std::errc::result_out_of_range, 0};
+    }
+    return acc;
+  }
+
+  template<class T, unsigned Base, class Ch>
+  constexpr parse_result<T>
+  parse_unsigned(Ch const * s, std::size_t n, std::size_t pos) noexcept
+  {
+    static_assert(std::is_integral<T>::value && std::is_unsigned<T>::value
+      && !std::is_same<T, bool>::value, "T must be an unsigned integer");
+    auto const r = parse_digits<Base>(s, n, pos, std::numeric_limits<T>::max());
+    if (!r) {
+      return {r.error(), r.error_position()};
+    }
+    return T(*r);
+  }
+
+  template<class T, class Ch>
+  constexpr parse_result<T> parse_signed(Ch const * s, std::size_t n) noexcept
+  {
+    static_assert(std::is_integral<T>::value && std::is_signed<T>::value,
+      "T must be a signed integer");
+    using U = std::make_unsigned_t<T>;
+    bool const neg = n && s[0] == Ch('-');
+    U const max = U(U(std::numeric_limits<T>::max()) + U(neg));
+    auto const r = parse_digits<10>(s, n, std::size_t(neg), max);
+    if (!r) {
+      return {r.error(), r.error_position()};
+    }
+    // the conversion of U(-x) to T is well defined since C++20
+    // and with all the supported compilers before
+    return neg ? T(U(U(0u) - U(*r))) : T(*r);
+  }
+
+  template<class T, class Ch>
+  constexpr parse_result<T> parse_hex(Ch const * s, std::size_t n) noexcept
+  {
+    std::size_t const pos
+      = (n > 2 && s[0] == Ch('0') && (s[1] == Ch('x') || s[1] == Ch('X')))
+      ? 2 : 0;
+    return parse_unsigned<T, 16>(s, n, pos);
+  }
+}
+
+
+/**
+ * \brief  Parses a decimal integer with an optional '-'.
+ *
+ * The whole string must be a number: no space, no '+', at least one digit.
+ * On error, the result is std::errc::invalid_argument or
+ * std::errc::result_out_of_range. At runtime, the digits of a string
+ * of \c char are read 8 at a time.
+ */
+template<class T = int, class Ch, std::size_t N, class Tr>
+constexpr parse_result<T>
+parse_int(basic_string_literal<Ch, N, Tr> const & str) noexcept
+{ return detail_::parse_signed<T>(str.data(), str.size()); }
+
+/// \brief  Parses a decimal integer without sign.
+/// \see parse_int()
+template<class T = unsigned, class Ch, std::size_t N, class Tr>
+constexpr parse_result<T>
+parse_uint(basic_string_literal<Ch, N, Tr> const & str) noexcept
+{ return detail_::parse_unsigned<T, 10>(str.data(), str.size(), 0); }
+
+/// \brief  Parses a hexadecimal integer, with an optional 0x or 0X prefix.
+/// \see parse_int()
+template<class T = unsigned, class Ch, std::size_t N, class Tr>
+constexpr parse_result<T>
+parse_hex(basic_string_literal<Ch, N, Tr> const & str) noexcept
+{ return detail_::parse_hex<T>(str.data(), str.size()); }
+
+#ifdef FALCON_STD_STRING_VIEW
+template<class T = int, class Ch, class Tr>
+constexpr parse_result<T>
+parse_int(FALCON_STD_STRING_VIEW<Ch, Tr> str) noexcept
+{ return detail_::parse_signed<T>(str.data(), str.size()); }
+
+template<class T = unsigned, class Ch, class Tr>
+constexpr parse_result<T>
+parse_uint(FALCON_STD_STRING_VIEW<Ch, Tr> str) noexcept
+{ return detail_::parse_unsigned<T, 10>(str.data(), str.size(), 0); }
+
+template<class T = unsigned, class Ch, class Tr>
+constexpr parse_result<T>
+parse_hex(FALCON_STD_STRING_VIEW<Ch, Tr> str) noexcept
+{ return detail_::parse_hex<T>(str.data(), str.size()); }
+#endif
+
+} }
@@ -0,0 +1,233 @@
+/* The MIT License (MIT)
+
+Copyright (c) 2016 jonathan poelen
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/**
+* \author    Jonathan Poelen <jonathan.poelen+falcon@gmail.com>
+* \version   1.0
+* \brief     Pool of basic_string_literal packed in one array, without duplicate
+*
+* \ingroup strings
+*/
+
+#pragma once
+
+#include <falcon/container/string_literal.hpp>
+#include <falcon/container/detail/throw_or_abort.hpp>
+#include <falcon/container/string_literal_fwd.hpp>
+#include <falcon/cxx/string_view.hpp>
+
+#include <cstdint>
+
+
+namespace falcon {
+inline namespace container {
+
+namespace detail_
+{
+  [[noreturn]] inline void string_literal_pool_too_small()
+  {
+    throw_or_abort<std::length_error>(
+      "basic_string_literal_pool::shrink: capacity < size()");
+  }
+}
+
+/// Position of a string in a basic_string_literal_pool.
+struct string_literal_pool_handle
+{
+  std::uint32_t offset;
+  std::uint32_t size;
+};
+
+/**
+ * \brief  Strings packed at compile time, for a constexpr object, in one
+ * null-terminated array.
+ *
+ * A string equal to another one or to the end of a longer one is not
+ * copied: "error", "io error" and "error" take 9 characters ("io error\0").
+ * The strings are accessed with their index in the constructor or with
+ * a string_literal_pool_handle of 2 32-bit integers.
+ *
+ * The capacity \a N of make_string_literal_pool() is the size without
+ * sharing; shrink() gives a pool of the used size:
+ * \code
+ * constexpr auto pool_ = make_string_literal_pool(lit("a"), lit("ba"));
+ * constexpr auto pool = pool_.shrink<pool_.size()>();
+ * \endcode
+ *
+ * \tparam Ch  Type of character.
+ * \tparam N  Capacity, null characters included.
+ * \tparam Count  Number of strings.
+ * \tparam Traits  Traits for character type.
+ */
+template<class Ch, std::size_t N, std::size_t Count, class Traits>
+class basic_string_literal_pool
+{
+  static_assert(N < (std::size_t(1) << 31), "too many characters for 32-bit handles");
+
+public:
+  using value_type = Ch;
+  using traits_type = Traits;
+  using size_type = std::size_t;
+  using handle_type = string_literal_pool_handle;
+
+  template<std::size_t... Ns>
+  constexpr explicit
+  basic_string_literal_pool(basic_string_literal<Ch, Ns, Traits> const & ... strs) noexcept
+  {
+    static_assert(sizeof...(Ns) == Count, "Count != number of strings");
+    Ch const * const ptrs[Count + 1] {strs.data()..., nullptr};
+    size_type const sizes[Count + 1] {strs.size()..., 0};
+
+    // the longest first, the shortest are then found at the end of them
+    size_type order[Count + 1] {};
+    for (size_type i = 0; i < Count; ++i) {
+      size_type j = i;
+      for (; j > 0 && sizes[order[j - 1]] < sizes[i]; --j) {
+        order[j] = order[j - 1];
+      }
+      order[j] = i;
+    }
+
+    // strings copied in data_
+    size_type copied[Count + 1] {};
+    size_type ncopied = 0;
+    for (size_type k = 0; k < Count; ++k) {
+      size_type const i = order[k];
+      if (!share_(i, ptrs[i], sizes[i], copied, ncopied)) {
+        handles_[i] = handle_type{std::uint32_t(size_), std::uint32_t(sizes[i])};
+        for (size_type c = 0; c < sizes[i]; ++c) {
+          data_[size_++] = ptrs[i][c];
+        }
+        data_[size_++] = Ch();
+        copied[ncopied++] = i;
+      }
+    }
+  }
+
+  /// Number of strings.
+  static constexpr size_type count() noexcept
+  { return Count; }
+
+  /// Number of used characters, null characters included.
+  constexpr size_type size() const noexcept
+  { return size_; }
+
+  static constexpr size_type capacity() noexcept
+  { return N; }
+
+  /// The packed strings, each one followed by a null character.
+  constexpr Ch const * data() const noexcept
+  { return data_; }
+
+  /// Handle of the \a i-th string of the constructor.
+  constexpr handle_type handle(size_type i) const noexcept
+  { return handles_[i]; }
+
+  /// Null-terminated string of \a h.
+  constexpr Ch const * c_str(handle_type h) const noexcept
+  { return data_ + h.offset; }
+
+  constexpr Ch const * c_str(size_type i) const noexcept
+  { return c_str(handles_[i]); }
+
+  /// Size of the \a i-th string.
+  constexpr size_type size(size_type i) const noexcept
+  { return handles_[i].size; }
+
+#ifdef FALCON_STD_STRING_VIEW
+  constexpr FALCON_STD_STRING_VIEW<Ch, Traits> view(handle_type h) const noexcept
+  { return {data_ + h.offset, h.size}; }
+
+  constexpr FALCON_STD_STRING_VIEW<Ch, Traits> operator[](size_type i) const noexcept
+  { return view(handles_[i]); }
+#endif
+
+  /// Same pool with a capacity of \a M.
+  /// \pre size() <= M
+  template<std::size_t M>
+  constexpr basic_string_literal_pool<Ch, M, Count, Traits> shrink() const
+  {
+    if (size_ > M) {
+      detail_::string_literal_pool_too_small();
+    }
+    basic_string_literal_pool<Ch, M, Count, Traits> pool{private_ctor{}};
+    for (size_type i = 0; i < size_; ++i) {
+      pool.data_[i] = data_[i];
+    }
+    for (size_type i = 0; i < Count; ++i) {
+      pool.handles_[i] = handles_[i];
+    }
+    pool.size_ = size_;
+    return pool;
+  }
+
+private:
+  template<class, std::size_t, std::size_t, class>
+  friend class basic_string_literal_pool;
+
+  struct private_ctor {};
+
+  template<class PrivateCtor>
+  constexpr explicit basic_string_literal_pool(PrivateCtor) noexcept
+  {}
+
+  /// Points \a i to the end of a copied string when possible.
+  constexpr bool share_(
+    size_type i, Ch const * s, size_type n,
+    size_type const * copied, size_type ncopied) noexcept
+  {
+    for (size_type k = 0; k < ncopied; ++k) {
+      handle_type const h = handles_[copied[k]];
+      if (h.size >= n) {
+        size_type const offset = h.offset + h.size - n;
+        size_type c = 0;
+        while (c < n && Traits::eq(data_[offset + c], s[c])) {
+          ++c;
+        }
+        if (c == n) {
+          handles_[i] = handle_type{std::uint32_t(offset), std::uint32_t(n)};
+          return true;
+        }
+      }
+    }
+    return false;
+  }
+
+  Ch data_[N + 1] {};
+  handle_type handles_[Count + 1] {};
+  size_type size_ = 0;
+};
+
+
+/// Creates a basic_string_literal_pool of \a strs, with a capacity of
+/// their sizes plus one null character each.
+template<class Ch, class Tr, std::size_t... Ns>
+constexpr basic_string_literal_pool<
+  Ch, detail_::sum_sizes<Ns...>() + sizeof...(Ns), sizeof...(Ns), Tr>
+make_string_literal_pool(basic_string_literal<Ch, Ns, Tr> const & ... strs) noexcept
+{
+  return basic_string_literal_pool<
+    Ch, detail_::sum_sizes<Ns...>() + sizeof...(Ns), sizeof...(Ns), Tr>{strs...};
+}
+
+} }
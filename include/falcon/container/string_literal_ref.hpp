@@ -0,0 +1,653 @@
+/* The MIT License (MIT)
+
+Copyright (c) 2016 jonathan poelen
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/**
+* \author    Jonathan Poelen <jonathan.poelen+falcon@gmail.com>
+* \version   1.0
+* \brief     Non-owning reference to the characters of a basic_string_literal
+*
+* \ingroup strings
+*/
+
+#pragma once
+
+#include <falcon/container/string_literal.hpp>
+#include <falcon/container/string_literal_fwd.hpp>
+
+#include <algorithm>
+
+
+namespace falcon {
+inline namespace container {
+
+/**
+ * \brief  Pointer on \a N characters with the const interface of
+ * basic_string_literal.
+ *
+ * A basic_literal_ref is trivially copyable and has the size of a pointer:
+ * passing it by value, storing it or taking a substr() never copies the
+ * characters. The referenced characters must outlive it, a reference to a
+ * temporary basic_string_literal does not compile.
+ *
+ * Unlike basic_string_literal, the characters are not null-terminated
+ * (substr() of a reference), there is no c_str().
+ *
+ * \tparam Ch  Type of character.
+ * \tparam N  Number of characters.
+ * \tparam Traits  Traits for character type.
+ */
+template<class Ch, std::size_t N, class Traits>
+struct basic_literal_ref
+{
+  using value_type = Ch;
+  using traits_type = Traits;
+
+  using const_pointer = Ch const *;
+  using const_reference = Ch const &;
+  using const_iterator = const_pointer;
+
+  using pointer = Ch const *;
+  using reference = Ch const &;
+  using iterator = pointer;
+
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+
+  static constexpr size_type npos = size_type(-1);
+
+  constexpr basic_literal_ref(basic_string_literal<Ch, N, Traits> const & str) noexcept
+  : p_(str.data())
+  {}
+
+  basic_literal_ref(basic_string_literal<Ch, N, Traits> const &&) = delete;
+
+  constexpr basic_literal_ref(Ch const (&arr)[N + 1]) noexcept
+  : p_(arr)
+  {}
+
+  constexpr basic_literal_ref(basic_literal_ref const &) noexcept = default;
+  basic_literal_ref & operator=(basic_literal_ref const &) noexcept = default;
+
+  constexpr size_type size() const noexcept { return N; }
+  constexpr size_type length() const noexcept { return N; }
+
+  /// Returns the size() of the largest possible %string, as basic_string_literal::max_size().
+  constexpr size_type max_size() const noexcept
+  {
+    return (npos - sizeof(size_type) - sizeof(void*))
+      / sizeof(value_type) / 4;
+  }
+
+  constexpr bool empty() const noexcept { return !N; }
+
+  constexpr const_reference operator[](size_type pos) const noexcept { return p_[pos]; }
+  constexpr const_reference front() const noexcept { return *p_; }
+  constexpr const_reference back() const noexcept { return p_[N-1]; }
+
+  constexpr const_iterator begin() const noexcept { return p_; }
+  constexpr const_iterator end() const noexcept { return p_ + N; }
+
+  constexpr const_iterator cbegin() const noexcept { return p_; }
+  constexpr const_iterator cend() const noexcept { return p_ + N; }
+
+  /// Return const pointer to the contents, not null-terminated.
+  constexpr const_pointer data() const noexcept { return p_; }
+
+  /// Reference to \a n characters from \a pos.
+  template<std::size_t pos, std::size_t n = npos>
+  constexpr basic_literal_ref<Ch, std::min(n, N - pos), Traits>
+  substr() const noexcept
+  {
+    static_assert(pos <= N, "out of range");
+    return basic_literal_ref<Ch, std::min(n, N - pos), Traits>{
+      detail_::private_ctor_str_lit{}, p_ + pos};
+  }
+
+  /// Copy of the characters.
+  constexpr basic_string_literal<Ch, N, Traits> str() const noexcept
+  { return detail_::core_access::mk_lit<N, Traits>(p_, N); }
+
+
+  // string compare
+  //@{
+  template<std::size_t M>
+  constexpr int
+  compare(basic_literal_ref<Ch, M, Traits> const & str) const noexcept
+  { return detail_::literal_compare<Ch, Traits, N, M>(p_, str.data()); }
+
+  template<std::size_t M>
+  constexpr int
+  compare(basic_string_literal<Ch, M, Traits> const & str) const noexcept
+  { return detail_::literal_compare<Ch, Traits, N, M>(p_, str.data()); }
+
+  constexpr int
+  compare(Ch const * s) const noexcept
+  { return algorithms_type_::compare_(view_(), {s}); }
+
+  constexpr int
+  compare(Ch const * s, size_type n) const noexcept
+  { return algorithms_type_::compare_(view_(), {s, n}); }
+
+  /// \throw std::out_of_range  \a pos1 > size()
+  template<std::size_t M>
+  constexpr int
+  compare(
+    size_type pos1, size_type n1
+  , basic_literal_ref<Ch, M, Traits> const & str) const
+  { return algorithms_type_::compare_(view_("compare", pos1, n1), {str.data(), M}); }
+
+  /// \throw std::out_of_range  \a pos1 > size()
+  template<std::size_t M>
+  constexpr int
+  compare(
+    size_type pos1, size_type n1
+  , basic_string_literal<Ch, M, Traits> const & str) const
+  { return algorithms_type_::compare_(view_("compare", pos1, n1), {str.data(), M}); }
+
+  /// \throw std::out_of_range  \a pos1 > size() or \a pos2 > str.size()
+  template<std::size_t M>
+  constexpr int
+  compare(
+    size_type pos1, size_type n1
+  , basic_literal_ref<Ch, M, Traits> const & str
+  , size_type pos2, size_type n2) const
+  {
+    return algorithms_type_::compare_(
+      view_("compare", pos1, n1),
+      view_(str.data(), M, "compare", pos2, n2));
+  }
+
+  /// \throw std::out_of_range  \a pos1 > size() or \a pos2 > str.size()
+  template<std::size_t M>
+  constexpr int
+  compare(
+    size_type pos1, size_type n1
+  , basic_string_literal<Ch, M, Traits> const & str
+  , size_type pos2, size_type n2) const
+  {
+    return algorithms_type_::compare_(
+      view_("compare", pos1, n1),
+      view_(str.data(), M, "compare", pos2, n2));
+  }
+
+  /// \throw std::out_of_range  \a pos1 > size()
+  constexpr int
+  compare(size_type pos1, size_type n1, Ch const * s) const
+  { return algorithms_type_::compare_(view_("compare", pos1, n1), {s}); }
+
+  /// \throw std::out_of_range  \a pos1 > size()
+  constexpr int
+  compare(size_type pos1, size_type n1, Ch const * s, size_type n2) const
+  { return algorithms_type_::compare_(view_("compare", pos1, n1), {s, n2}); }
+  //@}
+
+
+  // string search
+  //@{
+  template<std::size_t M>
+  constexpr size_type
+  find(basic_literal_ref<Ch, M, Traits> const & str, size_type pos = 0) const noexcept
+  { return algorithms_().find_({str.data(), M}, pos); }
+
+  template<std::size_t M>
+  constexpr size_type
+  find(basic_string_literal<Ch, M, Traits> const & str, size_type pos = 0) const noexcept
+  { return algorithms_().find_({str.data(), M}, pos); }
+
+  template<std::size_t M>
+  constexpr size_type
+  find(
+    basic_string_literal_searcher<Ch, M, Traits> const & searcher
+  , size_type pos = 0) const noexcept
+  { return searcher.find_in(p_, N, pos); }
+
+  /// \throw std::out_of_range  \a pos > size()
+  constexpr size_type
+  find(Ch c, size_type pos = 0) const
+  {
+    return pos <= N
+      ? algorithms_().find(c, pos)
+      : (throw_out_of_range_("find", pos, N), npos);
+  }
+
+  constexpr size_type
+  find(Ch const * s, size_type pos, size_type n) const noexcept
+  { return algorithms_().find_({s, n}, pos); }
+
+  constexpr size_type
+  find(Ch const * s, size_type pos = 0) const noexcept
+  { return algorithms_().find_({s}, pos); }
+
+
+  template<std::size_t M>
+  constexpr size_type
+  rfind(basic_literal_ref<Ch, M, Traits> const & str, size_type pos = npos) const noexcept
+  { return algorithms_().rfind_({str.data(), M}, pos); }
+
+  template<std::size_t M>
+  constexpr size_type
+  rfind(basic_string_literal<Ch, M, Traits> const & str, size_type pos = npos) const noexcept
+  { return algorithms_().rfind_({str.data(), M}, pos); }
+
+  template<std::size_t M>
+  constexpr size_type
+  rfind(
+    basic_string_literal_searcher<Ch, M, Traits> const & searcher
+  , size_type pos = npos) const noexcept
+  { return searcher.rfind_in(p_, N, pos); }
+
+  constexpr size_type
+  rfind(Ch c, size_type pos = npos) const noexcept
+  { return algorithms_().rfind(c, pos); }
+
+  constexpr size_type
+  rfind(Ch const * s, size_type pos, size_type n) const noexcept
+  { return algorithms_().rfind_({s, n}, pos); }
+
+  constexpr size_type
+  rfind(Ch const * s, size_type pos = npos) const noexcept
+  { return algorithms_().rfind_({s}, pos); }
+
+
+  template<std::size_t M>
+  constexpr size_type
+  find_first_of(basic_literal_ref<Ch, M, Traits> const & str, size_type pos = 0) const noexcept
+  { return algorithms_().find_first_of_({str.data(), M}, pos); }
+
+  template<std::size_t M>
+  constexpr size_type
+  find_first_of(basic_string_literal<Ch, M, Traits> const & str, size_type pos = 0) const noexcept
+  { return algorithms_().find_first_of_({str.data(), M}, pos); }
+
+  template<std::size_t M>
+  constexpr size_type
+  find_first_of(
+    basic_string_literal_charset<Ch, M, Traits> const & charset
+  , size_type pos = 0) const noexcept
+  { return charset.find_first_of_in(p_, N, pos); }
+
+  constexpr size_type
+  find_first_of(Ch c, size_type pos = 0) const
+  { return find(c, pos); }
+
+  constexpr size_type
+  find_first_of(Ch const * s, size_type pos, size_type n) const noexcept
+  { return algorithms_().find_first_of_({s, n}, pos); }
+
+  constexpr size_type
+  find_first_of(Ch const * s, size_type pos = 0) const noexcept
+  { return algorithms_().find_first_of_({s}, pos); }
+
+
+  template<std::size_t M>
+  constexpr size_type
+  find_last_of(basic_literal_ref<Ch, M, Traits> const & str, size_type pos = npos) const noexcept
+  { return algorithms_().find_last_of_({str.data(), M}, pos); }
+
+  template<std::size_t M>
+  constexpr size_type
+  find_last_of(basic_string_literal<Ch, M, Traits> const & str, size_type pos = npos) const noexcept
+  { return algorithms_().find_last_of_({str.data(), M}, pos); }
+
+  template<std::size_t M>
+  constexpr size_type
+  find_last_of(
+    basic_string_literal_charset<Ch, M, Traits> const & charset
+  , size_type pos = npos) const noexcept
+  { return charset.find_last_of_in(p_, N, pos); }
+
+  constexpr size_type
+  find_last_of(Ch c, size_type pos = npos) const noexcept
+  { return rfind(c, pos); }
+
+  constexpr size_type
+  find_last_of(Ch const * s, size_type pos, size_type n) const noexcept
+  { return algorithms_().find_last_of_({s, n}, pos); }
+
+  constexpr size_type
+  find_last_of(Ch const * s, size_type pos = npos) const noexcept
+  { return algorithms_().find_last_of_({s}, pos); }
+
+
+  template<std::size_t M>
+  constexpr size_type
+  find_first_not_of(basic_literal_ref<Ch, M, Traits> const & str, size_type pos = 0) const noexcept
+  { return algorithms_().find_first_not_of_({str.data(), M}, pos); }
+
+  template<std::size_t M>
+  constexpr size_type
+  find_first_not_of(basic_string_literal<Ch, M, Traits> const & str, size_type pos = 0) const noexcept
+  { return algorithms_().find_first_not_of_({str.data(), M}, pos); }
+
+  template<std::size_t M>
+  constexpr size_type
+  find_first_not_of(
+    basic_string_literal_charset<Ch, M, Traits> const & charset
+  , size_type pos = 0) const noexcept
+  { return charset.find_first_not_of_in(p_, N, pos); }
+
+  constexpr size_type
+  find_first_not_of(Ch c, size_type pos = 0) const noexcept
+  { return algorithms_().find_first_not_of(c, pos); }
+
+  constexpr size_type
+  find_first_not_of(Ch const * s, size_type pos, size_type n) const noexcept
+  { return algorithms_().find_first_not_of_({s, n}, pos); }
+
+  constexpr size_type
+  find_first_not_of(Ch const * s, size_type pos = 0) const noexcept
+  { return algorithms_().find_first_not_of_({s}, pos); }
+
+
+  template<std::size_t M>
+  constexpr size_type
+  find_last_not_of(basic_literal_ref<Ch, M, Traits> const & str, size_type pos = npos) const noexcept
+  { return algorithms_().find_last_not_of_({str.data(), M}, pos); }
+
+  template<std::size_t M>
+  constexpr size_type
+  find_last_not_of(basic_string_literal<Ch, M, Traits> const & str, size_type pos = npos) const noexcept
+  { return algorithms_().find_last_not_of_({str.data(), M}, pos); }
+
+  template<std::size_t M>
+  constexpr size_type
+  find_last_not_of(
+    basic_string_literal_charset<Ch, M, Traits> const & charset
+  , size_type pos = npos) const noexcept
+  { return charset.find_last_not_of_in(p_, N, pos); }
+
+  constexpr size_type
+  find_last_not_of(Ch c, size_type pos = npos) const noexcept
+  { return algorithms_().find_last_not_of(c, pos); }
+
+  constexpr size_type
+  find_last_not_of(Ch const * s, size_type pos, size_type n) const noexcept
+  { return algorithms_().find_last_not_of_({s, n}, pos); }
+
+  constexpr size_type
+  find_last_not_of(Ch const * s, size_type pos = npos) const noexcept
+  { return algorithms_().find_last_not_of_({s}, pos); }
+  //@}
+
+
+  /// Creates a std::basic_string with a copy of the referenced characters.
+  template<class Allocator = std::allocator<Ch>>
+  std::basic_string<Ch, Traits, Allocator>
+  to_string(Allocator const & a = Allocator()) const
+  { return {p_, N, a}; }
+
+#ifdef FALCON_STD_STRING_VIEW
+  constexpr FALCON_STD_STRING_VIEW<Ch, Traits>
+  to_string_view() const
+  { return {p_, N}; }
+
+  constexpr operator FALCON_STD_STRING_VIEW<Ch, Traits> () const
+  { return {p_, N}; }
+#endif
+
+private:
+  using algorithms_type_ = detail_::string_literal_algorithms<Ch, Traits>;
+  using string_view_ = detail_::string_view<Ch, Traits>;
+
+#ifndef __cpp_exceptions
+  static void throw_out_of_range_(char const *, size_type, size_type) {}
+#else
+  [[noreturn]] static void throw_out_of_range_(char const *, size_type pos, size_type n);
+#endif
+
+  constexpr algorithms_type_ algorithms_() const noexcept
+  { return {p_, N}; }
+
+  constexpr string_view_ view_() const noexcept
+  { return {p_, N}; }
+
+  constexpr string_view_ view_(
+    char const * func, size_type pos, size_type n) const
+  { return view_(p_, N, func, pos, n); }
+
+  static constexpr string_view_ view_(
+    Ch const * s, size_type sz
+  , char const * func, size_type pos, size_type n)
+  {
+    return pos <= sz
+      ? string_view_{s + pos, std::min(n, size_type(sz - pos))}
+      : (throw_out_of_range_(func, pos, sz), string_view_{});
+  }
+
+  template<class, std::size_t, class>
+  friend struct basic_literal_ref;
+
+  constexpr basic_literal_ref(detail_::private_ctor_str_lit, Ch const * p) noexcept
+  : p_(p)
+  {}
+
+  Ch const * p_;
+};
+
+#ifdef __cpp_exceptions
+template<class Ch, std::size_t N, class Traits>
+[[noreturn]] void basic_literal_ref<Ch, N, Traits>
+::throw_out_of_range_(char const * func, size_type pos, size_type n)
+{
+  char what_str[256];
+  std::snprintf(
+    what_str, sizeof(what_str),
+    "basic_literal_ref::%s: pos "
+    "(which is %zu) > size "
+    "(which is %zu)",
+    func, pos, n);
+  throw std::out_of_range(what_str);
+}
+#endif
+
+template<std::size_t n> using literal_ref = basic_literal_ref<char, n>;
+template<std::size_t n> using wliteral_ref = basic_literal_ref<wchar_t, n>;
+
+
+/// Creates a basic_literal_ref on the characters of \a str.
+template<class Ch, std::size_t N, class Tr>
+constexpr basic_literal_ref<Ch, N, Tr>
+make_literal_ref(basic_string_literal<Ch, N, Tr> const & str) noexcept
+{ return {str}; }
+
+template<class Ch, std::size_t N, class Tr>
+void make_literal_ref(basic_string_literal<Ch, N, Tr> const && str) = delete;
+
+
+template<class Ch, class Tr, std::size_t N>
+std::basic_ostream<Ch, Tr> &
+operator<<(std::basic_ostream<Ch, Tr> & out, basic_literal_ref<Ch, N, Tr> const & str)
+{ return iostreams::ostream_insert(out, str.data(), str.size()); }
+
+
+// string comparison
+//@{
+template<class Ch, class Tr, std::size_t n1, std::size_t n2>
+constexpr bool
+operator==(basic_literal_ref<Ch, n1, Tr> const & x, basic_literal_ref<Ch, n2, Tr> const & y) noexcept
+{
+  return detail_::literal_equal<Ch, Tr, n1>(
+    x.data(), y.data(), std::integral_constant<bool, n1 == n2>{});
+}
+
+template<class Ch, class Tr, std::size_t n1, std::size_t n2>
+constexpr bool
+operator==(basic_literal_ref<Ch, n1, Tr> const & x, basic_string_literal<Ch, n2, Tr> const & y) noexcept
+{
+  return detail_::literal_equal<Ch, Tr, n1>(
+    x.data(), y.data(), std::integral_constant<bool, n1 == n2>{});
+}
+
+template<class Ch, class Tr, std::size_t n1, std::size_t n2>
+constexpr bool
+operator==(basic_string_literal<Ch, n1, Tr> const & x, basic_literal_ref<Ch, n2, Tr> const & y) noexcept
+{
+  return detail_::literal_equal<Ch, Tr, n1>(
+    x.data(), y.data(), std::integral_constant<bool, n1 == n2>{});
+}
+
+template<class Ch, class Tr, std::size_t n>
+constexpr bool
+operator==(basic_literal_ref<Ch, n, Tr> const & x, Ch const * y) noexcept
+{ return x.compare(y) == 0; }
+
+template<class Ch, class Tr, std::size_t n>
+constexpr bool
+operator==(Ch const * x, basic_literal_ref<Ch, n, Tr> const & y) noexcept
+{ return y.compare(x) == 0; }
+
+template<class Ch, class Tr, std::size_t n1, std::size_t n2>
+constexpr bool
+operator!=(basic_literal_ref<Ch, n1, Tr> const & x, basic_literal_ref<Ch, n2, Tr> const & y) noexcept
+{ return !(x == y); }
+
+template<class Ch, class Tr, std::size_t n1, std::size_t n2>
+constexpr bool
+operator!=(basic_literal_ref<Ch, n1, Tr> const & x, basic_string_literal<Ch, n2, Tr> const & y) noexcept
+{ return !(x == y); }
+
+template<class Ch, class Tr, std::size_t n1, std::size_t n2>
+constexpr bool
+operator!=(basic_string_literal<Ch, n1, Tr> const & x, basic_literal_ref<Ch, n2, Tr> const & y) noexcept
+{ return !(x == y); }
+
+template<class Ch, class Tr, std::size_t n>
+constexpr bool
+operator!=(basic_literal_ref<Ch, n, Tr> const & x, Ch const * y) noexcept
+{ return !(x == y); }
+
+template<class Ch, class Tr, std::size_t n>
+constexpr bool
+operator!=(Ch const * x, basic_literal_ref<Ch, n, Tr> const & y) noexcept
+{ return !(x == y); }
+
+template<class Ch, class Tr, std::size_t n1, std::size_t n2>
+constexpr bool
+operator< (basic_literal_ref<Ch, n1, Tr> const & x, basic_literal_ref<Ch, n2, Tr> const & y) noexcept
+{ return x.compare(y) < 0; }
+
+template<class Ch, class Tr, std::size_t n1, std::size_t n2>
+constexpr bool
+operator> (basic_literal_ref<Ch, n1, Tr> const & x, basic_literal_ref<Ch, n2, Tr> const & y) noexcept
+{ return x.compare(y) > 0; }
+
+template<class Ch, class Tr, std::size_t n1, std::size_t n2>
+constexpr bool
+operator<=(basic_literal_ref<Ch, n1, Tr> const & x, basic_literal_ref<Ch, n2, Tr> const & y) noexcept
+{ return x.compare(y) <= 0; }
+
+template<class Ch, class Tr, std::size_t n1, std::size_t n2>
+constexpr bool
+operator>=(basic_literal_ref<Ch, n1, Tr> const & x, basic_literal_ref<Ch, n2, Tr> const & y) noexcept
+{ return x.compare(y) >= 0; }
+
+template<class Ch, class Tr, std::size_t n1, std::size_t n2>
+constexpr bool
+operator< (basic_literal_ref<Ch, n1, Tr> const & x, basic_string_literal<Ch, n2, Tr> const & y) noexcept
+{ return x.compare(y) < 0; }
+
+template<class Ch, class Tr, std::size_t n1, std::size_t n2>
+constexpr bool
+operator< (basic_string_literal<Ch, n1, Tr> const & x, basic_literal_ref<Ch, n2, Tr> const & y) noexcept
+{ return y.compare(x) > 0; }
+
+template<class Ch, class Tr, std::size_t n>
+constexpr bool
+operator< (basic_literal_ref<Ch, n, Tr> const & x, Ch const * y) noexcept
+{ return x.compare(y) < 0; }
+
+template<class Ch, class Tr, std::size_t n>
+constexpr bool
+operator< (Ch const * x, basic_literal_ref<Ch, n, Tr> const & y) noexcept
+{ return y.compare(x) > 0; }
+
+template<class Ch, class Tr, std::size_t n1, std::size_t n2>
+constexpr bool
+operator> (basic_literal_ref<Ch, n1, Tr> const & x, basic_string_literal<Ch, n2, Tr> const & y) noexcept
+{ return x.compare(y) > 0; }
+
+template<class Ch, class Tr, std::size_t n1, std::size_t n2>
+constexpr bool
+operator> (basic_string_literal<Ch, n1, Tr> const & x, basic_literal_ref<Ch, n2, Tr> const & y) noexcept
+{ return y.compare(x) < 0; }
+
+template<class Ch, class Tr, std::size_t n>
+constexpr bool
+operator> (basic_literal_ref<Ch, n, Tr> const & x, Ch const * y) noexcept
+{ return x.compare(y) > 0; }
+
+template<class Ch, class Tr, std::size_t n>
+constexpr bool
+operator> (Ch const * x, basic_literal_ref<Ch, n, Tr> const & y) noexcept
+{ return y.compare(x) < 0; }
+
+template<class Ch, class Tr, std::size_t n1, std::size_t n2>
+constexpr bool
+operator<=(basic_literal_ref<Ch, n1, Tr> const & x, basic_string_literal<Ch, n2, Tr> const & y) noexcept
+{ return x.compare(y) <= 0; }
+
+template<class Ch, class Tr, std::size_t n1, std::size_t n2>
+constexpr bool
+operator<=(basic_string_literal<Ch, n1, Tr> const & x, basic_literal_ref<Ch, n2, Tr> const & y) noexcept
+{ return y.compare(x) >= 0; }
+
+template<class Ch, class Tr, std::size_t n>
+constexpr bool
+operator<=(basic_literal_ref<Ch, n, Tr> const & x, Ch const * y) noexcept
+{ return x.compare(y) <= 0; }
+
+template<class Ch, class Tr, std::size_t n>
+constexpr bool
+operator<=(Ch const * x, basic_literal_ref<Ch, n, Tr> const & y) noexcept
+{ return y.compare(x) >= 0; }
+
+template<class Ch, class Tr, std::size_t n1, std::size_t n2>
+constexpr bool
+operator>=(basic_literal_ref<Ch, n1, Tr> const & x, basic_string_literal<Ch, n2, Tr> const & y) noexcept
+{ return x.compare(y) >= 0; }
+
+template<class Ch, class Tr, std::size_t n1, std::size_t n2>
+constexpr bool
+operator>=(basic_string_literal<Ch, n1, Tr> const & x, basic_literal_ref<Ch, n2, Tr> const & y) noexcept
+{ return y.compare(x) <= 0; }
+
+template<class Ch, class Tr, std::size_t n>
+constexpr bool
+operator>=(basic_literal_ref<Ch, n, Tr> const & x, Ch const * y) noexcept
+{ return x.compare(y) >= 0; }
+
+template<class Ch, class Tr, std::size_t n>
+constexpr bool
+operator>=(Ch const * x, basic_literal_ref<Ch, n, Tr> const & y) noexcept
+{ return y.compare(x) <= 0; }
+//@}
+
+} }
+
+namespace std
+{
+  template<class Ch, size_t N, class Tr>
+  struct hash<::falcon::container::basic_literal_ref<Ch, N, Tr>>
+  : ::falcon::fnv1a_hash<::falcon::container::basic_literal_ref<Ch, N, Tr>>
+  {};
+}
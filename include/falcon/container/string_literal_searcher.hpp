@@ -0,0 +1,208 @@
+/* The MIT License (MIT)
+
+Copyright (c) 2016 jonathan poelen
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/**
+* \author    Jonathan Poelen <jonathan.poelen+falcon@gmail.com>
+* \version   1.0
+* \brief     Boyer-Moore-Horspool searcher for string literals
+*
+* \ingroup strings
+*/
+
+#pragma once
+
+#include <falcon/container/string_literal.hpp>
+
+#include <type_traits>
+#include <utility> // std::pair
+#include <cstdint>
+
+
+namespace falcon {
+inline namespace container {
+
+/**
+ * \brief  Boyer-Moore-Horspool searcher whose skip tables are computed
+ * from a basic_string_literal, at compile time for a constexpr object.
+ *
+ * Usable with basic_string_literal::find(), basic_string_literal::rfind()
+ * and std::search().
+ *
+ * Characters are distributed in 256 buckets, a bucket shared by several
+ * characters keeps the smallest shift. \c Traits must be std::char_traits
+ * or ci_char_traits: the characters equal with \c Traits::eq must share
+ * a bucket.
+ *
+ * \tparam Ch  Type of character.
+ * \tparam N  Size of the pattern.
+ * \tparam Traits  Traits for character type.
+ */
+template<class Ch, std::size_t N, class Traits>
+struct basic_string_literal_searcher
+{
+  static_assert(std::is_same<Traits, std::char_traits<Ch>>::value
+    || std::is_same<Traits, ci_char_traits<Ch>>::value,
+    "basic_string_literal_searcher: Traits must be std::char_traits or ci_char_traits");
+
+  using value_type = Ch;
+  using traits_type = Traits;
+  using size_type = std::size_t;
+  using shift_type = std::conditional_t<(N < 0x100u), std::uint8_t,
+    std::conditional_t<(N < 0x10000u), std::uint16_t, std::size_t>>;
+
+  static constexpr size_type npos = size_type(-1);
+
+  constexpr explicit
+  basic_string_literal_searcher(
+    basic_string_literal<Ch, N, Traits> const & str) noexcept
+  : str_(str)
+  {
+    for (std::size_t i = 0; i < 256; ++i) {
+      shift_[i] = shift_type(N);
+      rshift_[i] = shift_type(N);
+    }
+    for (std::size_t i = 0; i + 1 < N; ++i) {
+      shift_[bucket_(str[i])] = shift_type(N - 1 - i);
+    }
+    for (std::size_t i = N; i-- > 1; ) {
+      rshift_[bucket_(str[i])] = shift_type(i);
+    }
+  }
+
+  /// Returns the pattern.
+  constexpr basic_string_literal<Ch, N, Traits> const &
+  pattern() const noexcept
+  { return str_; }
+
+  /**
+   * \brief  Find position of the pattern.
+   * \param s  String to search into.
+   * \param n  Number of characters of \a s.
+   * \param pos  Index of character to search from (default 0).
+   * \return  Index of start of first occurrence or npos.
+   */
+  constexpr size_type
+  find_in(Ch const * s, size_type n, size_type pos = 0) const noexcept
+  { return search_(s, n, pos); }
+
+  /**
+   * \brief  Find last position of the pattern.
+   * \param s  String to search into.
+   * \param n  Number of characters of \a s.
+   * \param pos  Index of character to search back from (default end).
+   * \return  Index of start of last occurrence or npos.
+   */
+  constexpr size_type
+  rfind_in(Ch const * s, size_type n, size_type pos = npos) const noexcept;
+
+  /// Searcher interface of std::search().
+  template<class RandIt>
+  constexpr std::pair<RandIt, RandIt>
+  operator()(RandIt first, RandIt last) const
+  {
+    size_type const pos = search_(first, size_type(last - first), 0);
+    return pos == npos
+      ? std::pair<RandIt, RandIt>{last, last}
+      : std::pair<RandIt, RandIt>{first + pos, first + pos + N};
+  }
+
+private:
+  static constexpr std::size_t bucket_(Ch c) noexcept
+  {
+    // the characters equal with ci_char_traits::eq share a bucket
+    return std::size_t(static_cast<std::make_unsigned_t<Ch>>(
+      std::is_same<Traits, ci_char_traits<Ch>>::value
+        ? detail_::ascii_to_lower(c) : c)) & 0xffu;
+  }
+
+  template<class RandIt>
+  constexpr size_type
+  search_(RandIt s, size_type n, size_type pos) const;
+
+  basic_string_literal<Ch, N, Traits> str_;
+  shift_type shift_[256] {};
+  shift_type rshift_[256] {};
+};
+
+
+/// Creates a basic_string_literal_searcher object, deducing the target type from the types of arguments.
+template<class Ch, std::size_t N, class Tr>
+constexpr basic_string_literal_searcher<Ch, N, Tr>
+make_string_literal_searcher(basic_string_literal<Ch, N, Tr> const & str) noexcept
+{ return basic_string_literal_searcher<Ch, N, Tr>{str}; }
+
+
+// Implementation
+
+template<class Ch, std::size_t N, class Tr>
+template<class RandIt>
+constexpr typename basic_string_literal_searcher<Ch, N, Tr>::size_type
+basic_string_literal_searcher<Ch, N, Tr>
+::search_(RandIt s, size_type n, size_type pos) const
+{
+  if (N == 0) {
+    return pos <= n ? pos : npos;
+  }
+
+  if (N <= n) {
+    for (; pos <= n - N; pos += shift_[bucket_(s[pos + N - 1])]) {
+      std::size_t i = N;
+      while (i-- > 0 && traits_type::eq(s[pos + i], str_[i])) {
+      }
+      if (i == std::size_t(-1)) {
+        return pos;
+      }
+    }
+  }
+
+  return npos;
+}
+
+template<class Ch, std::size_t N, class Tr>
+constexpr typename basic_string_literal_searcher<Ch, N, Tr>::size_type
+basic_string_literal_searcher<Ch, N, Tr>
+::rfind_in(Ch const * s, size_type n, size_type pos) const noexcept
+{
+  if (N <= n) {
+    pos = std::min(size_type(n - N), pos);
+    for (;;) {
+      std::size_t i = 0;
+      while (i < N && traits_type::eq(s[pos + i], str_[i])) {
+        ++i;
+      }
+      if (i == N) {
+        return pos;
+      }
+      size_type const shift = rshift_[bucket_(s[pos])];
+      if (pos < shift) {
+        break;
+      }
+      pos -= shift;
+    }
+  }
+
+  return npos;
+}
+
+} // container
+}
@@ -0,0 +1,337 @@
+/* The MIT License (MIT)
+
+Copyright (c) 2016 jonathan poelen
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/**
+* \author    Jonathan Poelen <jonathan.poelen+falcon@gmail.com>
+* \version   1.0
+* \brief     Constexpr conversions between UTF-8, UTF-16 and UTF-32 literals
+*
+* \ingroup strings
+*/
+
+#pragma once
+
+#include <falcon/container/string_literal.hpp>
+#include <falcon/container/detail/throw_or_abort.hpp>
+
+#include <type_traits>
+#include <cstdint>
+
+
+namespace falcon {
+inline namespace container {
+
+namespace detail_
+{
+  [[noreturn]] inline void transcode_invalid_sequence()
+  {
+    throw_or_abort<std::invalid_argument>("transcode: invalid UTF sequence");
+  }
+
+  [[noreturn]] inline void transcode_bad_size()
+  {
+    throw_or_abort<std::length_error>("transcode: M != transcoded_size()");
+  }
+
+  /// Size in bits of the code units of \a Ch: char and char8_t are UTF-8,
+  /// wchar_t is UTF-16 or UTF-32 according to its size.
+  template<class Ch>
+  using utf_width = std::integral_constant<int,
+    std::is_same<Ch, char16_t>::value ? 16
+    : std::is_same<Ch, char32_t>::value ? 32
+    : std::is_same<Ch, wchar_t>::value ? (sizeof(wchar_t) == 2 ? 16 : 32)
+    : 8>;
+
+  struct utf_decoded
+  {
+    char32_t cp;
+    /// number of code units, 0 for an invalid sequence
+    std::size_t len;
+  };
+
+  template<class Ch>
+  constexpr utf_decoded utf_decode(
+    Ch const * s, std::size_t n, std::integral_constant<int, 8>) noexcept
+  {
+    unsigned const c0 = static_cast<unsigned char>(s[0]);
+    if (c0 < 0x80) {
+      return {char32_t(c0), 1};
+    }
+
+    std::size_t const len
+      = (c0 >= 0xC2 && c0 <= 0xDF) ? 2
+      : (c0 >= 0xE0 && c0 <= 0xEF) ? 3
+      : (c0 >= 0xF0 && c0 <= 0xF4) ? 4
+      : 0;
+    if (!len || n < len) {
+      return {0, 0};
+    }
+
+    std::uint32_t cp = c0 & (0x7Fu >> len);
+    for (std::size_t k = 1; k < len; ++k) {
+      unsigned const c = static_cast<unsigned char>(s[k]);
+      if ((c & 0xC0u) != 0x80u) {
+        return {0, 0};
+      }
+      cp = (cp << 6) | (c & 0x3Fu);
+    }
+
+    // overlong encoding, surrogate or beyond U+10FFFF
+    std::uint32_t const min = len == 2 ? 0x80u : len == 3 ? 0x800u : 0x10000u;
+    if (cp < min || (cp >= 0xD800u && cp <= 0xDFFFu) || cp > 0x10FFFFu) {
+      return {0, 0};
+    }
+    return {char32_t(cp), len};
+  }
+
+  template<class Ch>
+  constexpr utf_decoded utf_decode(
+    Ch const * s, std::size_t n, std::integral_constant<int, 16>) noexcept
+  {
+    std::uint32_t const u = std::uint32_t(s[0]) & 0xFFFFu;
+    if (u < 0xD800u || u > 0xDFFFu) {
+      return {char32_t(u), 1};
+    }
+    if (u > 0xDBFFu || n < 2) {
+      return {0, 0};
+    }
+    std::uint32_t const u2 = std::uint32_t(s[1]) & 0xFFFFu;
+    if (u2 < 0xDC00u || u2 > 0xDFFFu) {
+      return {0, 0};
+    }
+    return {char32_t(0x10000u + ((u - 0xD800u) << 10) + (u2 - 0xDC00u)), 2};
+  }
+
+  template<class Ch>
+  constexpr utf_decoded utf_decode(
+    Ch const * s, std::size_t, std::integral_constant<int, 32>) noexcept
+  {
+    std::uint32_t const u = std::uint32_t(s[0]);
+    if ((u >= 0xD800u && u <= 0xDFFFu) || u > 0x10FFFFu) {
+      return {0, 0};
+    }
+    return {char32_t(u), 1};
+  }
+
+  constexpr std::size_t utf_encoded_size(
+    char32_t cp, std::integral_constant<int, 8>) noexcept
+  { return cp < 0x80 ? 1 : cp < 0x800 ? 2 : cp < 0x10000 ? 3 : 4; }
+
+  constexpr std::size_t utf_encoded_size(
+    char32_t cp, std::integral_constant<int, 16>) noexcept
+  { return cp < 0x10000 ? 1 : 2; }
+
+  constexpr std::size_t utf_encoded_size(
+    char32_t, std::integral_constant<int, 32>) noexcept
+  { return 1; }
+
+  template<class To>
+  constexpr std::size_t utf_encode(
+    char32_t cp, To * out, std::integral_constant<int, 8>) noexcept
+  {
+    using uchar = unsigned char;
+    std::uint32_t const u = cp;
+    if (u < 0x80u) {
+      out[0] = To(uchar(u));
+      return 1;
+    }
+    if (u < 0x800u) {
+      out[0] = To(uchar(0xC0u | (u >> 6)));
+      out[1] = To(uchar(0x80u | (u & 0x3Fu)));
+      return 2;
+    }
+    if (u < 0x10000u) {
+      out[0] = To(uchar(0xE0u | (u >> 12)));
+      out[1] = To(uchar(0x80u | ((u >> 6) & 0x3Fu)));
+      out[2] = To(uchar(0x80u | (u & 0x3Fu)));
+      return 3;
+    }
+    out[0] = To(uchar(0xF0u | (u >> 18)));
+    out[1] = To(uchar(0x80u | ((u >> 12) & 0x3Fu)));
+    out[2] = To(uchar(0x80u | ((u >> 6) & 0x3Fu)));
+    out[3] = To(uchar(0x80u | (u & 0x3Fu)));
+    return 4;
+  }
+
+  template<class To>
+  constexpr std::size_t utf_encode(
+    char32_t cp, To * out, std::integral_constant<int, 16>) noexcept
+  {
+    std::uint32_t const u = cp;
+    if (u < 0x10000u) {
+      out[0] = To(u);
+      return 1;
+    }
+    out[0] = To(0xD800u + ((u - 0x10000u) >> 10));
+    out[1] = To(0xDC00u + ((u - 0x10000u) & 0x3FFu));
+    return 2;
+  }
+
+  template<class To>
+  constexpr std::size_t utf_encode(
+    char32_t cp, To * out, std::integral_constant<int, 32>) noexcept
+  {
+    out[0] = To(cp);
+    return 1;
+  }
+
+  struct transcode_status
+  {
+    /// size of the converted string (of the valid prefix on error)
+    std::size_t size;
+    /// index of the first invalid code unit, the input size when valid
+    std::size_t error_position;
+    bool valid;
+  };
+
+  template<class To, class Ch>
+  constexpr transcode_status
+  transcode_check(Ch const * s, std::size_t n) noexcept
+  {
+    std::size_t size = 0;
+    for (std::size_t i = 0; i < n; ) {
+      utf_decoded const d = utf_decode(s + i, n - i, utf_width<Ch>{});
+      if (!d.len) {
+        return {size, i, false};
+      }
+      size += utf_encoded_size(d.cp, utf_width<To>{});
+      i += d.len;
+    }
+    return {size, n, true};
+  }
+
+  template<class To, std::size_t M, class ToTr, class Ch>
+  constexpr basic_string_literal<To, M, ToTr>
+  transcode(Ch const * s, std::size_t n)
+  {
+    To buf[M + 1] {};
+    std::size_t j = 0;
+    for (std::size_t i = 0; i < n; ) {
+      utf_decoded const d = utf_decode(s + i, n - i, utf_width<Ch>{});
+      if (!d.len) {
+        transcode_invalid_sequence();
+      }
+      // encoded apart: the bound check and the copy use the same length
+      To units[4] {};
+      std::size_t const len = utf_encode(d.cp, units, utf_width<To>{});
+      if (M - j < len) {
+        transcode_bad_size();
+      }
+      for (std::size_t k = 0; k < len; ++k) {
+        buf[j++] = units[k];
+      }
+      i += d.len;
+    }
+    if (j != M) {
+      transcode_bad_size();
+    }
+    return core_access::mk_lit<M, ToTr>(buf, M);
+  }
+}
+
+
+/**
+ * \brief  Number of code units of \a str converted to the encoding of \a To.
+ *
+ * The encoding is UTF-8 for char (and char8_t), UTF-16 for char16_t,
+ * UTF-32 for char32_t and UTF-16 or UTF-32 for wchar_t, according to its
+ * size.
+ *
+ * \exception std::invalid_argument  \a str is not a valid UTF sequence
+ * (an overlong form, a surrogate, an unpaired surrogate or beyond U+10FFFF):
+ * not a constant expression.
+ */
+template<class To, class Ch, std::size_t N, class Tr>
+constexpr std::size_t
+transcoded_size(basic_string_literal<Ch, N, Tr> const & str)
+{
+  auto const status = detail_::transcode_check<To>(str.data(), N);
+  if (!status.valid) {
+    detail_::transcode_invalid_sequence();
+  }
+  return status.size;
+}
+
+/**
+ * \brief  Converts \a str to the encoding of \a To.
+ *
+ * \code
+ * constexpr auto s = lit(u8"caf\u00e9");
+ * constexpr auto u16 = transcode<char16_t, transcoded_size<char16_t>(s)>(s);
+ * \endcode
+ *
+ * \pre  M == transcoded_size<To>(str)
+ * \exception std::invalid_argument  invalid UTF sequence
+ * \exception std::length_error  \a M is not the converted size
+ */
+template<class To, std::size_t M, class ToTr = std::char_traits<To>,
+  class Ch, std::size_t N, class Tr>
+constexpr basic_string_literal<To, M, ToTr>
+transcode(basic_string_literal<Ch, N, Tr> const & str)
+{ return detail_::transcode<To, M, ToTr>(str.data(), N); }
+
+/**
+ * \brief  Converts \c Constant::value, a basic_string_literal, to the
+ * encoding of \a To. The size is computed and an invalid sequence fails
+ * on a static_assert.
+ *
+ * \code
+ * struct path { static constexpr auto value = lit(u8"C:\\caf\u00e9"); };
+ * constexpr auto wpath = transcode<wchar_t, path>();
+ * \endcode
+ */
+template<class To, class Constant, class ToTr = std::char_traits<To>>
+constexpr basic_string_literal<To,
+  detail_::transcode_check<To>(Constant::value.data(), Constant::value.size()).size,
+  ToTr>
+transcode() noexcept
+{
+  constexpr auto status = detail_::transcode_check<To>(
+    Constant::value.data(), Constant::value.size());
+  static_assert(status.valid, "transcode: invalid UTF sequence");
+  return detail_::transcode<To, status.size, ToTr>(
+    Constant::value.data(), Constant::value.size());
+}
+
+#if defined(__cpp_nontype_template_args) && __cpp_nontype_template_args >= 201411L
+/**
+ * \brief  Converts \a str, a basic_string_literal with static storage
+ * duration, to the encoding of \a To.
+ *
+ * \code
+ * constexpr auto s = lit(u8"caf\u00e9"); // at namespace scope
+ * constexpr auto u16 = transcode<char16_t, s>();
+ * \endcode
+ */
+template<class To, auto const & str, class ToTr = std::char_traits<To>>
+constexpr basic_string_literal<To,
+  detail_::transcode_check<To>(str.data(), str.size()).size, ToTr>
+transcode() noexcept
+{
+  constexpr auto status = detail_::transcode_check<To>(str.data(), str.size());
+  static_assert(status.valid, "transcode: invalid UTF sequence");
+  return detail_::transcode<To, status.size, ToTr>(str.data(), str.size());
+}
+#endif
+
+} }
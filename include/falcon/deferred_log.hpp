@@ -0,0 +1,615 @@
+/* The MIT License (MIT)
+
+Copyright (c) 2016 jonathan poelen
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/**
+* \author    Jonathan Poelen <jonathan.poelen+falcon@gmail.com>
+* \version   1.0
+* \brief     Deferred binary logging: (string_id, raw arguments) records
+*
+* \ingroup strings
+*/
+
+#pragma once
+
+#include <falcon/string_id.hpp>
+#include <falcon/container/string_literal_format.hpp>
+#include <falcon/container/detail/throw_or_abort.hpp>
+
+#include <atomic>
+#include <algorithm>
+#include <initializer_list>
+#include <mutex>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <vector>
+#include <unordered_map>
+#include <type_traits>
+#include <utility>
+#include <cstdint>
+#include <cstring>
+
+
+namespace falcon {
+
+/// Encoding of an argument in the payload of a record.
+enum class deferred_log_arg_type : std::uint8_t
+{
+  /// a character of the format
+  character,
+  /// integer of \c size bytes, in the byte order of the logging machine
+  signed_integer,
+  unsigned_integer,
+  /// length (std::uint32_t) then the characters of \c size bytes
+  string,
+};
+
+/// Argument of a format, given by basic_deferred_log_registry::for_each().
+struct deferred_log_arg_desc
+{
+  deferred_log_arg_type type;
+  std::uint8_t size;
+};
+
+namespace detail_
+{
+  [[noreturn]] inline void deferred_log_id_collision()
+  {
+    container::detail_::throw_or_abort<std::invalid_argument>(
+      "deferred_log_registry: two formats with the same string_id");
+  }
+
+  [[noreturn]] inline void deferred_log_bad_arity()
+  {
+    container::detail_::throw_or_abort<std::invalid_argument>(
+      "deferred_log_registry: number of arguments != arity() of the format");
+  }
+
+  [[noreturn]] inline void deferred_log_signature_mismatch()
+  {
+    container::detail_::throw_or_abort<std::invalid_argument>(
+      "deferred_log_registry: format already registered with other argument types");
+  }
+
+  /// Unique address per list of argument types.
+  template<class... Args>
+  struct deferred_log_signature
+  {
+    static constexpr char tag = 0;
+  };
+
+  template<class... Args>
+  constexpr char deferred_log_signature<Args...>::tag;
+
+  /**
+   * String argument decoded from a record (not null-terminated).
+   * The characters are copied when they are not aligned on alignof(Ch).
+   */
+  template<class Ch, class Traits>
+  struct deferred_log_string
+  {
+    Ch const * data() const noexcept
+    { return copy_.empty() ? data_ : copy_.data(); }
+
+    std::size_t size() const noexcept { return size_; }
+
+    void assign(unsigned char const * p, std::size_t n)
+    {
+      if (reinterpret_cast<std::uintptr_t>(p) % alignof(Ch)) {
+        copy_.resize(n);
+        std::memcpy(&copy_[0], p, n * sizeof(Ch));
+      }
+      else {
+        data_ = reinterpret_cast<Ch const *>(p);
+      }
+      size_ = n;
+    }
+
+  private:
+    Ch const * data_ = nullptr;
+    std::size_t size_ = 0;
+    std::basic_string<Ch, Traits> copy_ {};
+  };
+
+  /// 0: raw bytes (character or integer), 1: C string, 2: data() and size()
+  template<class Ch, class T>
+  using deferred_log_arg_kind = std::integral_constant<int,
+    (std::is_same<T, Ch>::value || std::is_integral<T>::value) ? 0
+    : std::is_convertible<T const &, Ch const *>::value ? 1
+    : 2>;
+
+  template<class Ch, class Traits, class T,
+    int = deferred_log_arg_kind<Ch, T>::value>
+  struct deferred_log_arg
+  {
+    using decoded_type = T;
+
+    static constexpr deferred_log_arg_desc desc() noexcept
+    {
+      return {
+        std::is_same<T, Ch>::value ? deferred_log_arg_type::character
+        : std::is_signed<T>::value ? deferred_log_arg_type::signed_integer
+        : deferred_log_arg_type::unsigned_integer,
+        std::uint8_t(sizeof(T))};
+    }
+
+    static std::size_t size(T const &) noexcept
+    { return sizeof(T); }
+
+    template<class Out>
+    static void write(Out & out, T const & x) noexcept
+    { out.put(&x, sizeof(T)); }
+
+    /// \return  false when fewer than sizeof(T) bytes remain before \a end
+    static bool read(
+      unsigned char const * & p, unsigned char const * end, T & x) noexcept
+    {
+      if (static_cast<std::size_t>(end - p) < sizeof(T)) {
+        return false;
+      }
+      std::memcpy(&x, p, sizeof(T));
+      p += sizeof(T);
+      return true;
+    }
+  };
+
+  /// strings: length (std::uint32_t) followed by the characters
+  template<class Ch, class Traits, class T, int Kind>
+  struct deferred_log_string_arg
+  {
+    using decoded_type = deferred_log_string<Ch, Traits>;
+
+    static constexpr deferred_log_arg_desc desc() noexcept
+    { return {deferred_log_arg_type::string, std::uint8_t(sizeof(Ch))}; }
+
+    static Ch const * data_(T const & x, std::integral_constant<int, 1>) noexcept
+    { return x; }
+
+    static std::size_t size_(T const & x, std::integral_constant<int, 1>) noexcept
+    { return Traits::length(x); }
+
+    static Ch const * data_(T const & x, std::integral_constant<int, 2>) noexcept
+    { return x.data(); }
+
+    static std::size_t size_(T const & x, std::integral_constant<int, 2>) noexcept
+    { return x.size(); }
+
+    static std::size_t size(T const & x) noexcept
+    {
+      return sizeof(std::uint32_t)
+        + size_(x, std::integral_constant<int, Kind>{}) * sizeof(Ch);
+    }
+
+    template<class Out>
+    static void write(Out & out, T const & x) noexcept
+    {
+      std::integral_constant<int, Kind> kind;
+      auto const n = static_cast<std::uint32_t>(size_(x, kind));
+      out.put(&n, sizeof(n));
+      out.put(data_(x, kind), n * sizeof(Ch));
+    }
+
+    /// \return  false when the length or the characters exceed \a end
+    static bool read(
+      unsigned char const * & p, unsigned char const * end,
+      decoded_type & x)
+    {
+      std::uint32_t n;
+      if (static_cast<std::size_t>(end - p) < sizeof(n)) {
+        return false;
+      }
+      std::memcpy(&n, p, sizeof(n));
+      p += sizeof(n);
+      if (static_cast<std::size_t>(end - p) / sizeof(Ch) < n) {
+        return false;
+      }
+      x.assign(p, n);
+      p += n * sizeof(Ch);
+      return true;
+    }
+  };
+
+  template<class Ch, class Traits, class T>
+  struct deferred_log_arg<Ch, Traits, T, 1>
+  : deferred_log_string_arg<Ch, Traits, T, 1>
+  {};
+
+  template<class Ch, class Traits, class T>
+  struct deferred_log_arg<Ch, Traits, T, 2>
+  : deferred_log_string_arg<Ch, Traits, T, 2>
+  {};
+
+  template<class... Ts>
+  constexpr bool deferred_log_has_floating_point() noexcept
+  {
+    bool const is_fp[] {false, std::is_floating_point<Ts>::value...};
+    for (bool b : is_fp) {
+      if (b) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  template<class T> struct deferred_log_identity { using type = T; };
+}
+
+/**
+ * \brief  Handle returned by basic_deferred_log_registry::add().
+ *
+ * It carries the string_id of the format and the types of the arguments.
+ */
+template<class Ch, class... Args>
+struct deferred_log_site
+{
+  std::size_t id;
+};
+
+/**
+ * \brief  Formats of the log call sites, indexed by their string_id.
+ *
+ * A call site registers its format once (typically in a static local
+ * variable). The records are decoded by the same registry, in the
+ * background thread, or offline with the dictionary given by for_each():
+ * the format and the encoding of each argument. add() and decode() are
+ * thread-safe.
+ *
+ * \code
+ * static auto const site = registry.add<int, char const *>(
+ *   lit("user {} logged from {}"));
+ * buffer.log(site, uid, host);
+ * \endcode
+ */
+template<class Ch, class Traits = std::char_traits<Ch>>
+class basic_deferred_log_registry
+{
+  struct entry
+  {
+    entry(
+      std::basic_string<Ch, Traits> fmt, void const * sig,
+      std::vector<deferred_log_arg_desc> descs)
+    : format(std::move(fmt))
+    , signature(sig)
+    , arg_descs(std::move(descs))
+    {}
+
+    entry(entry const &) = delete;
+    entry & operator=(entry const &) = delete;
+
+    virtual ~entry() = default;
+
+    virtual bool decode(
+      unsigned char const * p, std::size_t n,
+      std::basic_string<Ch, Traits> & out) const = 0;
+
+    std::basic_string<Ch, Traits> const format;
+    /// address of detail_::deferred_log_signature<Args...>::tag
+    void const * const signature;
+    std::vector<deferred_log_arg_desc> const arg_descs;
+  };
+
+  template<std::size_t N, class... Args>
+  struct entry_impl final : entry
+  {
+    entry_impl(basic_string_literal<Ch, N, Traits> const & fmt)
+    : entry(
+      fmt.to_string(), &detail_::deferred_log_signature<Args...>::tag,
+      {arg_<Args>::desc()...})
+    , fmt_(fmt)
+    {
+      if (fmt_.arity() != sizeof...(Args)) {
+        detail_::deferred_log_bad_arity();
+      }
+    }
+
+    bool decode(
+      unsigned char const * p, std::size_t n,
+      std::basic_string<Ch, Traits> & out) const override
+    {
+      std::tuple<typename arg_<Args>::decoded_type...> args {};
+      if (!read_(p, p + n, args, std::index_sequence_for<Args...>{})) {
+        return false;
+      }
+      append_(out, args, std::index_sequence_for<Args...>{});
+      return true;
+    }
+
+  private:
+    template<class T>
+    using arg_ = detail_::deferred_log_arg<Ch, Traits, T>;
+
+    template<class Tuple, std::size_t... Ints>
+    static bool read_(
+      unsigned char const * p, unsigned char const * end, Tuple & args,
+      std::index_sequence<Ints...>)
+    {
+      bool ok = true;
+      // braced initialization: arguments are read from left to right
+      (void)std::initializer_list<int>{
+        (ok = ok && arg_<Args>::read(p, end, std::get<Ints>(args)), 0)...};
+      return ok && p == end;
+    }
+
+    template<class Tuple, std::size_t... Ints>
+    void append_(
+      std::basic_string<Ch, Traits> & out, Tuple const & args,
+      std::index_sequence<Ints...>) const
+    {
+      std::size_t const pos = out.size();
+      out.resize(pos + fmt_.formatted_size(std::get<Ints>(args)...));
+      fmt_.format_to(&out[pos], std::get<Ints>(args)...);
+    }
+
+    basic_string_literal_format<Ch, N, Traits> fmt_;
+  };
+
+public:
+  /**
+   * \brief  Registers \a fmt, the format of the arguments \a Args.
+   *
+   * Registering the same format again returns the same site.
+   * \throw std::invalid_argument  the arity of \a fmt is not
+   * sizeof...(Args), another format has the same string_id or
+   * \a fmt is already registered with other argument types.
+   */
+  template<class... Args, std::size_t N>
+  deferred_log_site<Ch, std::decay_t<Args>...>
+  add(basic_string_literal<Ch, N, Traits> const & fmt)
+  {
+    static_assert(
+      !detail_::deferred_log_has_floating_point<std::decay_t<Args>...>(),
+      "basic_deferred_log_registry::add: floating point arguments are not supported");
+
+    std::size_t const id = string_id(fmt);
+    std::unique_ptr<entry> e{new entry_impl<N, std::decay_t<Args>...>(fmt)};
+
+    std::lock_guard<std::mutex> lock{mutex_};
+    auto const r = entries_.emplace(id, std::move(e));
+    if (!r.second) {
+      if (r.first->second->format != fmt.to_string()) {
+        detail_::deferred_log_id_collision();
+      }
+      if (r.first->second->signature
+       != &detail_::deferred_log_signature<std::decay_t<Args>...>::tag) {
+        detail_::deferred_log_signature_mismatch();
+      }
+    }
+    return {id};
+  }
+
+  /**
+   * \brief  Appends to \a out the message of a record.
+   * \return  false when \a id is unknown or the payload is malformed.
+   */
+  bool decode(
+    std::size_t id, unsigned char const * payload, std::size_t n,
+    std::basic_string<Ch, Traits> & out) const
+  {
+    entry const * e;
+    {
+      std::lock_guard<std::mutex> lock{mutex_};
+      auto const it = entries_.find(id);
+      if (it == entries_.end()) {
+        return false;
+      }
+      e = it->second.get();
+    }
+    return e->decode(payload, n, out);
+  }
+
+  /**
+   * \brief  Calls \c f(id, format, args) for each registered format, with
+   * \c args a std::vector<deferred_log_arg_desc> (dictionary for an
+   * offline decoder).
+   */
+  template<class F>
+  void for_each(F f) const
+  {
+    std::lock_guard<std::mutex> lock{mutex_};
+    for (auto const & p : entries_) {
+      f(p.first, p.second->format, p.second->arg_descs);
+    }
+  }
+
+  std::size_t size() const
+  {
+    std::lock_guard<std::mutex> lock{mutex_};
+    return entries_.size();
+  }
+
+private:
+  mutable std::mutex mutex_ {};
+  std::unordered_map<std::size_t, std::unique_ptr<entry>> entries_ {};
+};
+
+using deferred_log_registry = basic_deferred_log_registry<char>;
+using wdeferred_log_registry = basic_deferred_log_registry<wchar_t>;
+
+
+/**
+ * \brief  Lock-free ring buffer of log records for one producer and one
+ * consumer (one buffer per logging thread).
+ *
+ * A record is <code>[std::uint32_t payload size][std::size_t id][payload]</code>,
+ * the payload is the arguments in their binary representation, strings
+ * are copied (length then characters), as described by
+ * deferred_log_arg_desc. log() never blocks nor allocates:
+ * when the buffer is full, the record is dropped and counted.
+ */
+template<class Ch, class Traits = std::char_traits<Ch>>
+class basic_deferred_log_buffer
+{
+  static constexpr std::size_t header_size
+    = sizeof(std::uint32_t) + sizeof(std::size_t);
+
+  struct writer_
+  {
+    unsigned char * data;
+    std::size_t mask;
+    std::size_t pos;
+
+    void put(void const * p, std::size_t n) noexcept
+    {
+      std::size_t const i = pos & mask;
+      std::size_t const n1 = std::min(n, mask + 1 - i);
+      std::memcpy(data + i, p, n1);
+      std::memcpy(data, static_cast<unsigned char const *>(p) + n1, n - n1);
+      pos += n;
+    }
+  };
+
+  template<class T>
+  using arg_ = detail_::deferred_log_arg<Ch, Traits, T>;
+
+public:
+  /// \a capacity is rounded up to a power of 2.
+  explicit basic_deferred_log_buffer(std::size_t capacity = 1 << 16)
+  : mask_(round_capacity_(capacity) - 1)
+  , data_(new unsigned char[mask_ + 1])
+  {}
+
+  basic_deferred_log_buffer(basic_deferred_log_buffer const &) = delete;
+  basic_deferred_log_buffer & operator=(basic_deferred_log_buffer const &) = delete;
+
+  std::size_t capacity() const noexcept { return mask_ + 1; }
+
+  /// Number of records dropped because the buffer was full.
+  std::size_t dropped() const noexcept
+  { return dropped_.load(std::memory_order_relaxed); }
+
+  /**
+   * \brief  Writes a record (producer side).
+   * \return  false when the buffer is full (the record is dropped).
+   */
+  template<class... Args>
+  bool log(
+    deferred_log_site<Ch, Args...> const & site,
+    typename detail_::deferred_log_identity<Args>::type const & ... args) noexcept
+  {
+    std::size_t payload = 0;
+    (void)std::initializer_list<int>{
+      (void(payload += arg_<Args>::size(args)), 0)...};
+    std::size_t const n = header_size + payload;
+
+    std::size_t const head = head_.load(std::memory_order_relaxed);
+    std::size_t const tail = tail_.load(std::memory_order_acquire);
+    if (n > capacity() - (head - tail) || payload > std::uint32_t(-1)) {
+      dropped_.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+
+    writer_ out{data_.get(), mask_, head};
+    auto const payload32 = static_cast<std::uint32_t>(payload);
+    out.put(&payload32, sizeof(payload32));
+    out.put(&site.id, sizeof(site.id));
+    (void)std::initializer_list<int>{(arg_<Args>::write(out, args), 0)...};
+
+    head_.store(out.pos, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * \brief  Reads the available records (consumer side).
+   *
+   * Calls \c f(id, payload, payload_size) for each record, the payload is
+   * valid until \a f returns.
+   * \return  Number of records read.
+   */
+  template<class F>
+  std::size_t consume(F && f)
+  {
+    std::size_t tail = tail_.load(std::memory_order_relaxed);
+    std::size_t const head = head_.load(std::memory_order_acquire);
+    std::size_t count = 0;
+
+    while (tail != head) {
+      unsigned char header[header_size];
+      read_(header, tail, header_size);
+      std::uint32_t payload;
+      std::size_t id;
+      std::memcpy(&payload, header, sizeof(payload));
+      std::memcpy(&id, header + sizeof(payload), sizeof(id));
+
+      std::size_t const first = (tail + header_size) & mask_;
+      unsigned char const * p = data_.get() + first;
+      if (first + payload > capacity()) {
+        scratch_.resize(payload);
+        read_(scratch_.data(), tail + header_size, payload);
+        p = scratch_.data();
+      }
+      f(id, p, std::size_t(payload));
+
+      tail += header_size + payload;
+      tail_.store(tail, std::memory_order_release);
+      ++count;
+    }
+
+    return count;
+  }
+
+  /// Decodes the available records with \a registry and calls \c f(message) for each (consumer side).
+  template<class F>
+  std::size_t consume(
+    basic_deferred_log_registry<Ch, Traits> const & registry, F && f)
+  {
+    std::basic_string<Ch, Traits> msg;
+    return consume([&](std::size_t id, unsigned char const * p, std::size_t n) {
+      msg.clear();
+      if (registry.decode(id, p, n, msg)) {
+        f(msg);
+      }
+    });
+  }
+
+private:
+  static std::size_t round_capacity_(std::size_t n) noexcept
+  {
+    n = std::max(n, header_size * 2);
+    std::size_t c = 1;
+    while (c < n) {
+      c *= 2;
+    }
+    return c;
+  }
+
+  void read_(unsigned char * out, std::size_t pos, std::size_t n) const noexcept
+  {
+    std::size_t const i = pos & mask_;
+    std::size_t const n1 = std::min(n, capacity() - i);
+    std::memcpy(out, data_.get() + i, n1);
+    std::memcpy(out + n1, data_.get(), n - n1);
+  }
+
+  // producer and consumer indexes on separate cache lines
+  alignas(64) std::atomic<std::size_t> head_ {0};
+  alignas(64) std::atomic<std::size_t> tail_ {0};
+  alignas(64) std::atomic<std::size_t> dropped_ {0};
+  std::size_t const mask_;
+  std::unique_ptr<unsigned char[]> const data_;
+  std::vector<unsigned char> scratch_ {};
+};
+
+using deferred_log_buffer = basic_deferred_log_buffer<char>;
+using wdeferred_log_buffer = basic_deferred_log_buffer<wchar_t>;
+
+}
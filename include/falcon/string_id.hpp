@@ -51,8 +51,8 @@ string_id(Ch const * s) noexcept
   struct znull {};
   struct iterator {
     Ch const * s;
-    iterator & operator++() noexcept { ++s; return *this; }
-    Ch operator*() const noexcept { return *s; }
+    constexpr iterator & operator++() noexcept { ++s; return *this; }
+    constexpr Ch operator*() const noexcept { return *s; }
     constexpr bool operator != (znull) const noexcept { return *s; }
   };
   return fnv1a_hash_fn{}(iterator{s}, znull{});
@@ -77,6 +77,12 @@ inline namespace container
   template<class Ch, class Tr, std::size_t N>
   constexpr std::size_t string_id(basic_string_literal<Ch, N, Tr> const & str)
   { return fnv1a_hash_fn{}(str.data(), str.data() + str.size()); }
+
+  /// Precomputed FNV-1a hash
+  template<class Ch, class Tr, std::size_t N>
+  constexpr std::size_t
+  string_id(basic_hashed_string_literal<Ch, N, Tr> const & str) noexcept
+  { return str.hash(); }
 }
 
 }
@@ -0,0 +1,229 @@
+/* The MIT License (MIT)
+
+Copyright (c) 2016 jonathan poelen
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/**
+* \author    Jonathan Poelen <jonathan.poelen+falcon@gmail.com>
+* \version   1.0
+* \brief     switch on strings with string_id
+*
+* \ingroup strings
+*/
+
+#pragma once
+
+#include <falcon/string_id.hpp>
+#include <falcon/container/string_literal.hpp>
+#include <falcon/container/detail/throw_or_abort.hpp>
+#include <falcon/cxx/string_view.hpp>
+
+#include <type_traits>
+#include <cstdint>
+
+
+namespace falcon {
+
+namespace detail_
+{
+  [[noreturn]] inline void string_switch_has_colliding_labels()
+  {
+    container::detail_::throw_or_abort<std::invalid_argument>(
+      "basic_string_switch: colliding labels");
+  }
+
+  [[noreturn]] inline void string_switch_table_not_found()
+  {
+    container::detail_::throw_or_abort<std::runtime_error>(
+      "basic_string_switch: no table");
+  }
+}
+
+/**
+ * \brief  Checked switch on strings.
+ *
+ * The constructor, evaluated at compile time for a constexpr object,
+ * rejects labels with the same string_id() and searches a table size where
+ * each string_id() has its own slot.
+ * operator() returns the string_id() of a string only when the string is
+ * one of the labels (one hash, one probe, one size check and one memcmp),
+ * otherwise it returns no_match.
+ *
+ * \code
+ * constexpr auto commands = make_string_switch(lit("start"), lit("stop"));
+ * switch (commands(s)) {
+ *   case string_id("start"): ...
+ *   case string_id("stop"): ...
+ *   default: ...
+ * }
+ * \endcode
+ *
+ * \tparam Ch  Type of character.
+ * \tparam Traits  Traits for character type.
+ * \tparam NLabels  Number of labels.
+ * \tparam Total  Sum of the sizes of the labels.
+ */
+template<class Ch, class Traits, std::size_t NLabels, std::size_t Total>
+struct basic_string_switch
+{
+  using value_type = Ch;
+  using traits_type = Traits;
+  using size_type = std::size_t;
+
+  /// Returned by operator() when the string is not a label.
+  static constexpr std::size_t no_match = std::size_t(-1);
+
+  static constexpr size_type npos = size_type(-1);
+
+private:
+  static constexpr std::size_t n_ = NLabels ? NLabels : 1;
+  static constexpr std::size_t max_table_size = n_ * 8;
+
+  using index_type = container::detail_::uint_least_for<NLabels + 1>;
+  using offset_type = container::detail_::uint_least_for<Total + 1>;
+
+public:
+  /**
+   * \throw std::invalid_argument  two labels have the same string_id.
+   * \throw std::runtime_error  no table is found.
+   */
+  template<std::size_t... Ns>
+  constexpr explicit
+  basic_string_switch(
+    basic_string_literal<Ch, Ns, Traits> const & ... labels)
+  {
+    static_assert(sizeof...(Ns) == NLabels, "bad number of labels");
+    static_assert(
+      container::detail_::sum_sizes<Ns...>() == Total, "bad total size");
+    Ch const * strings[n_] {labels.data()...};
+    std::size_t const sizes[n_] {labels.size()...};
+
+    std::size_t offset = 0;
+    for (std::size_t i = 0; i < NLabels; ++i) {
+      offsets_[i] = offset_type(offset);
+      sizes_[i] = offset_type(sizes[i]);
+      ids_[i] = string_id(strings[i], sizes[i]);
+      container::detail_::acpy(chars_ + offset, strings[i], sizes[i]);
+      offset += sizes[i];
+    }
+
+    for (std::size_t i = 0; i < NLabels; ++i) {
+      if (ids_[i] == no_match) {
+        detail_::string_switch_has_colliding_labels();
+      }
+      for (std::size_t j = i + 1; j < NLabels; ++j) {
+        if (ids_[i] == ids_[j]) {
+          detail_::string_switch_has_colliding_labels();
+        }
+      }
+    }
+
+    for (table_size_ = n_; table_size_ <= max_table_size; ++table_size_) {
+      std::size_t i = 0;
+      for (; i < NLabels; ++i) {
+        auto & slot = table_[ids_[i] % table_size_];
+        if (slot) {
+          break;
+        }
+        slot = index_type(i + 1);
+      }
+      if (i == NLabels) {
+        return;
+      }
+      for (std::size_t j = 0; j < max_table_size; ++j) {
+        table_[j] = 0;
+      }
+    }
+    detail_::string_switch_table_not_found();
+  }
+
+  /// Number of labels.
+  constexpr size_type size() const noexcept { return NLabels; }
+
+  /// Returns string_id(s, n) if \a s is a label, otherwise no_match.
+  constexpr std::size_t operator()(Ch const * s, size_type n) const noexcept
+  {
+    std::size_t const id = string_id(s, n);
+    std::size_t const i = table_[id % table_size_];
+    return i && equal_label_(i - 1, s, n) ? id : no_match;
+  }
+
+  /// Returns string_id(s) if \a s is a label, otherwise no_match.
+  constexpr std::size_t operator()(Ch const * s) const noexcept
+  {
+    return (*this)(
+      s, container::detail_::constexpr_char_traits<Ch, Traits>::length(s));
+  }
+
+#ifdef FALCON_STD_STRING_VIEW
+  /// Returns string_id(str) if \a str is a label, otherwise no_match.
+  constexpr std::size_t
+  operator()(FALCON_STD_STRING_VIEW<Ch, Traits> str) const noexcept
+  { return (*this)(str.data(), str.size()); }
+#endif
+
+  /// Returns string_id(str) if \a str is a label, otherwise no_match.
+  template<std::size_t N>
+  constexpr std::size_t
+  operator()(basic_string_literal<Ch, N, Traits> const & str) const noexcept
+  { return (*this)(str.data(), str.size()); }
+
+  /// Returns the index of the label \a s or npos.
+  constexpr size_type index_of(Ch const * s, size_type n) const noexcept
+  {
+    std::size_t const i = table_[string_id(s, n) % table_size_];
+    return i && equal_label_(i - 1, s, n) ? i - 1 : npos;
+  }
+
+  /// Returns the string_id() of the label \a i.
+  constexpr std::size_t id(size_type i) const noexcept
+  { return ids_[i]; }
+
+private:
+  constexpr bool
+  equal_label_(std::size_t i, Ch const * s, std::size_t n) const noexcept
+  {
+    return sizes_[i] == n
+      && 0 == container::detail_::constexpr_char_traits<Ch, Traits>
+        ::compare(chars_ + offsets_[i], s, n);
+  }
+
+  std::size_t table_size_ = n_;
+  // index + 1 of the label of a slot
+  index_type table_[max_table_size] {};
+  std::size_t ids_[n_] {};
+  offset_type offsets_[n_] {};
+  offset_type sizes_[n_] {};
+  Ch chars_[Total ? Total : 1] {};
+};
+
+
+template<class Ch, class Tr, std::size_t... Ns>
+using string_switch_for = basic_string_switch<
+  Ch, Tr, sizeof...(Ns), container::detail_::sum_sizes<Ns...>()>;
+
+/// Creates a basic_string_switch object, deducing the target type from the types of arguments.
+template<class Ch, class Tr, std::size_t... Ns>
+constexpr string_switch_for<Ch, Tr, Ns...>
+make_string_switch(basic_string_literal<Ch, Ns, Tr> const & ... labels)
+{ return string_switch_for<Ch, Tr, Ns...>{labels...}; }
+
+}
@@ -0,0 +1,40 @@
+/* The MIT License (MIT)
+
+Copyright (c) 2016 jonathan poelen
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+// FALCON_IS_CONSTANT_EVALUATED() is only defined when the compiler can tell
+// a constant evaluation from a runtime call, including in C++14 mode.
+#if defined(__has_builtin)
+# if __has_builtin(__builtin_is_constant_evaluated)
+#  define FALCON_IS_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+# endif
+#endif
+
+#if !defined(FALCON_IS_CONSTANT_EVALUATED)
+# if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 9
+#  define FALCON_IS_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+# elif defined(_MSC_VER) && _MSC_VER >= 1925
+#  define FALCON_IS_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+# endif
+#endif
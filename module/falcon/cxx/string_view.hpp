@@ -26,9 +26,9 @@ SOFTWARE.
 #if __cplusplus > 201402L
 # if __has_include(<string_view>)
 #  include <string_view>
-#  define FALCON_STD_STRING_VIEW ::std::string_view
+#  define FALCON_STD_STRING_VIEW ::std::basic_string_view
 # elif __has_include(<experimental/string_view>)
 #  include <experimental/string_view>
-#  define FALCON_STD_STRING_VIEW ::std::experimental::string_view
+#  define FALCON_STD_STRING_VIEW ::std::experimental::basic_string_view
 # endif
 #endif
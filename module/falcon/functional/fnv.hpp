@@ -24,18 +24,21 @@ SOFTWARE.
 /**
 * \author    Jonathan Poelen <jonathan.poelen+falcon@gmail.com>
 * \version   1.0
-* \brief     Fowler–Noll–Vo hash (FNV)
+* \brief     Fowler–Noll–Vo hash (FNV) and word-at-a-time hash (wymum)
 *
 * \ingroup functors
 */
 
 #pragma once
 
+#include <falcon/cxx/is_constant_evaluated.hpp>
+
 #include <type_traits>
 #include <iterator>
 
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 
 
 namespace falcon {
@@ -122,4 +125,160 @@ struct fnv_hash
 template<class T> using fnv1_hash = fnv_hash<fnv1_hash_fn, T>;
 template<class T> using fnv1a_hash = fnv_hash<fnv1a_hash_fn, T>;
 
+
+/**
+ * \brief  Word-at-a-time hash built on the mixing function of wyhash.
+ *
+ * Characters are packed in 64-bit words (little endian order of their
+ * unsigned values, \c sizeof(value_type) bytes per character), each word
+ * is mixed with a 64x64->128 bits multiplication. The result does not
+ * depend on the evaluation: at runtime, a range of pointers is read with
+ * memcpy instead of character by character.
+ *
+ * \note  This is not compatible with the reference wyhash, which reads
+ * its input from both ends and does not work with forward iterators.
+ */
+template<std::uint64_t Seed = 0>
+struct wymum_fn
+{
+  template<class FwIt, class Senti>
+  constexpr std::uint64_t operator()(FwIt first, Senti const & senti) noexcept
+  {
+#ifdef FALCON_IS_CONSTANT_EVALUATED
+    if (is_contiguous_<FwIt, Senti>::value
+      && !FALCON_IS_CONSTANT_EVALUATED()) {
+      return contiguous_(first, senti, is_contiguous_<FwIt, Senti>{});
+    }
+#endif
+
+    using ch_type = std::remove_cv_t<std::remove_reference_t<decltype(*first)>>;
+    using uch_type = std::make_unsigned_t<ch_type>;
+    constexpr unsigned ch_bits = sizeof(ch_type) * 8u;
+
+    std::uint64_t h = Seed ^ secret0_;
+    std::uint64_t w = 0;
+    unsigned shift = 0;
+    std::uint64_t len = 0;
+    for (; first != senti; ++first) {
+      w |= std::uint64_t(static_cast<uch_type>(*first)) << shift;
+      shift += ch_bits;
+      len += sizeof(ch_type);
+      if (shift == 64) {
+        h = mix_word_(h, w);
+        w = 0;
+        shift = 0;
+      }
+    }
+    return finalize_(h, w, len);
+  }
+
+private:
+  static constexpr std::uint64_t secret0_ = 0xa0761d6478bd642full;
+  static constexpr std::uint64_t secret1_ = 0xe7037ed1a0b428dbull;
+  static constexpr std::uint64_t secret2_ = 0x8ebc6af09c88c6e3ull;
+  static constexpr std::uint64_t secret3_ = 0x589965cc75374cc3ull;
+
+#if defined(__SIZEOF_INT128__)
+  __extension__ typedef unsigned __int128 uint128_;
+#endif
+
+  /// 64x64 -> 128 bits multiplication, returns low ^ high.
+  static constexpr std::uint64_t mum_(std::uint64_t a, std::uint64_t b) noexcept
+  {
+#if defined(__SIZEOF_INT128__)
+    uint128_ const r = uint128_(a) * b;
+    return std::uint64_t(r) ^ std::uint64_t(r >> 64);
+#else
+    std::uint64_t const ha = a >> 32, hb = b >> 32;
+    std::uint64_t const la = a & 0xffffffffu, lb = b & 0xffffffffu;
+    std::uint64_t const rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+    std::uint64_t const t = rl + (rm0 << 32);
+    std::uint64_t const lo = t + (rm1 << 32);
+    std::uint64_t const hi = rh + (rm0 >> 32) + (rm1 >> 32)
+      + (t < rl) + (lo < t);
+    return lo ^ hi;
+#endif
+  }
+
+  template<class It, class Senti>
+  struct is_contiguous_ : std::false_type
+  {};
+
+  // the bytes of a word read with memcpy are those of the constexpr
+  // algorithm only on little endian
+#if (defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__) \
+  || defined(_MSC_VER)
+  template<class Ch>
+  struct is_contiguous_<Ch const *, Ch const *>
+  : std::integral_constant<bool,
+    std::is_integral<Ch>::value && (8 % sizeof(Ch) == 0)>
+  {};
+
+  template<class Ch>
+  struct is_contiguous_<Ch *, Ch *>
+  : is_contiguous_<Ch const *, Ch const *>
+  {};
+#endif
+
+  static constexpr std::uint64_t
+  mix_word_(std::uint64_t h, std::uint64_t w) noexcept
+  {
+    return mum_(
+      w ^ secret1_, h ^ secret2_);
+  }
+
+  static constexpr std::uint64_t
+  finalize_(std::uint64_t h, std::uint64_t tail, std::uint64_t len) noexcept
+  {
+    h = mum_(
+      tail ^ secret1_, h ^ secret3_ ^ len);
+    return mum_(h ^ secret0_, len ^ secret1_);
+  }
+
+  template<class It, class Senti>
+  static std::uint64_t contiguous_(It, Senti const &, std::false_type) noexcept
+  {
+    return 0;
+  }
+
+  template<class Ptr>
+  static std::uint64_t contiguous_(Ptr first, Ptr last, std::true_type) noexcept
+  {
+    using ch_type = std::remove_cv_t<std::remove_pointer_t<Ptr>>;
+    constexpr std::size_t chars_per_word = 8 / sizeof(ch_type);
+
+    std::uint64_t h = Seed ^ secret0_;
+    std::size_t const n = std::size_t(last - first);
+    std::size_t const nwords = n / chars_per_word;
+    for (std::size_t i = 0; i < nwords; ++i, first += chars_per_word) {
+      std::uint64_t w;
+      std::memcpy(&w, first, 8);
+      h = mix_word_(h, w);
+    }
+    std::uint64_t tail = 0;
+    std::size_t const rest = n % chars_per_word;
+    if (rest) {
+      std::memcpy(&tail, first, rest * sizeof(ch_type));
+    }
+    return finalize_(h, tail, std::uint64_t(n * sizeof(ch_type)));
+  }
+};
+
+using wymum_64_fn = wymum_fn<>;
+
+/// wymum_64_fn folded to the size of std::size_t.
+struct wymum_hash_fn
+{
+  template<class FwIt, class Senti>
+  constexpr std::size_t operator()(FwIt && first, Senti const & senti) noexcept
+  {
+    std::uint64_t const h = wymum_64_fn{}(first, senti);
+    return sizeof(std::size_t) >= 8
+      ? std::size_t(h)
+      : std::size_t(h ^ (h >> 32));
+  }
+};
+
+template<class T> using wymum_hash = fnv_hash<wymum_hash_fn, T>;
+
 }
@@ -0,0 +1,247 @@
+/* The MIT License (MIT)
+
+Copyright (c) 2016 jonathan poelen
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/**
+* \author    Jonathan Poelen <jonathan.poelen+falcon@gmail.com>
+* \version   1.0
+* \brief     Scatter/gather writer, several strings in one writev
+*/
+
+#pragma once
+
+#include <iosfwd>
+#include <algorithm>
+#include <cstddef>
+
+#if defined(__unix__) || defined(__APPLE__)
+# include <sys/uio.h>
+# include <unistd.h>
+# include <climits>
+# include <cerrno>
+# define FALCON_IOSTREAMS_HAS_WRITEV 1
+#endif
+
+
+namespace falcon {
+namespace iostreams {
+
+/**
+ * \brief  Collects up to \a Capacity strings without copying them and
+ * writes them in one go.
+ *
+ * The strings are referenced, they must outlive the writer (or the next
+ * clear()). Any type with \c data() and \c size() can be pushed
+ * (basic_string_literal, std::basic_string, std::basic_string_view, ...).
+ *
+ * When more than \a Capacity strings are pushed, the extra strings are
+ * dropped and the writer becomes bad: good() returns false and the
+ * writes fail without writing anything.
+ */
+template<class CharT, std::size_t Capacity = 64>
+class basic_gather_writer
+{
+  static_assert(Capacity > 0, "Capacity must be greater than 0");
+
+  struct piece
+  {
+    CharT const * data;
+    std::size_t size;
+  };
+
+public:
+  using char_type = CharT;
+  using size_type = std::size_t;
+
+  basic_gather_writer() noexcept
+  {}
+
+  basic_gather_writer(basic_gather_writer const &) = delete;
+  basic_gather_writer & operator=(basic_gather_writer const &) = delete;
+
+  basic_gather_writer & push(CharT const * s, std::size_t n) noexcept
+  {
+    if (n) {
+      if (count_ == Capacity) {
+        good_ = false;
+      }
+      else {
+        pieces_[count_++] = piece{s, n};
+        bytes_ += n * sizeof(CharT);
+      }
+    }
+    return *this;
+  }
+
+  template<class String>
+  basic_gather_writer & push(String const & str) noexcept
+  { return push(str.data(), str.size()); }
+
+  /// Only the pointer is kept: a temporary would dangle.
+  template<class String>
+  basic_gather_writer & push(String const &&) = delete;
+
+  template<class String>
+  basic_gather_writer & operator<<(String const & str) noexcept
+  { return push(str.data(), str.size()); }
+
+  template<class String>
+  basic_gather_writer & operator<<(String const &&) = delete;
+
+  /// Number of strings.
+  size_type size() const noexcept { return count_; }
+  /// Total size in bytes.
+  size_type bytes() const noexcept { return bytes_; }
+  bool empty() const noexcept { return !count_; }
+  static constexpr size_type capacity() noexcept { return Capacity; }
+  /// false when a string has been dropped.
+  bool good() const noexcept { return good_; }
+
+  void clear() noexcept
+  {
+    count_ = 0;
+    bytes_ = 0;
+    good_ = true;
+  }
+
+  /**
+   * Writes the strings with sputn, under a single sentry.
+   * Sets badbit when a string is not entirely written and failbit when
+   * the writer is bad.
+   */
+  template<class Traits>
+  std::basic_ostream<CharT, Traits> &
+  write_to(std::basic_ostream<CharT, Traits> & out) const
+  {
+    using ostream_type = std::basic_ostream<CharT, Traits>;
+    using ios_base = typename ostream_type::ios_base;
+
+    if (!good_) {
+      out.setstate(ios_base::failbit);
+    }
+    else if (typename ostream_type::sentry cerb{out}) {
+      if (!write_to(*out.rdbuf())) {
+        out.setstate(ios_base::badbit);
+      }
+    }
+
+    return out;
+  }
+
+  /// Writes the strings with sputn. Returns false on a short write.
+  template<class Traits>
+  bool write_to(std::basic_streambuf<CharT, Traits> & buf) const
+  {
+    if (!good_) {
+      return false;
+    }
+    for (piece const * p = pieces_; p != pieces_ + count_; ++p) {
+      auto const n = static_cast<std::streamsize>(p->size);
+      if (buf.sputn(p->data, n) != n) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+#ifdef FALCON_IOSTREAMS_HAS_WRITEV
+  /**
+   * Writes the strings on \a fd with writev(2), with one system call
+   * when possible. Partial writes are continued and \c EINTR is retried.
+   * \return  false on error, errno is set by writev.
+   */
+  bool write_to(int fd) const noexcept
+  {
+    if (!good_) {
+      errno = EINVAL;
+      return false;
+    }
+
+#ifdef IOV_MAX
+    constexpr std::size_t iov_max = IOV_MAX;
+#else
+    constexpr std::size_t iov_max = 1024;
+#endif
+    constexpr std::size_t niov = Capacity < iov_max ? Capacity : iov_max;
+
+    ::iovec iov[niov];
+    piece const * first = pieces_;
+    piece const * const last = pieces_ + count_;
+    // number of bytes already written of *first
+    std::size_t offset = 0;
+
+    while (first != last) {
+      std::size_t const n = std::min(niov, std::size_t(last - first));
+      for (std::size_t i = 0; i < n; ++i) {
+        iov[i].iov_base = const_cast<CharT *>(first[i].data);
+        iov[i].iov_len = first[i].size * sizeof(CharT);
+      }
+      iov[0].iov_base = static_cast<char *>(iov[0].iov_base) + offset;
+      iov[0].iov_len -= offset;
+
+      ::ssize_t const r = ::writev(fd, iov, static_cast<int>(n));
+      if (r < 0) {
+        if (errno == EINTR) {
+          continue;
+        }
+        return false;
+      }
+      if (r == 0) {
+        errno = EIO;
+        return false;
+      }
+
+      std::size_t written = static_cast<std::size_t>(r);
+      std::size_t i = 0;
+      for (; i < n && written >= iov[i].iov_len; ++i) {
+        written -= iov[i].iov_len;
+      }
+      offset = (i == 0 ? offset : 0) + written;
+      first += i;
+    }
+
+    return true;
+  }
+#endif
+
+private:
+  piece pieces_[Capacity];
+  std::size_t count_ = 0;
+  std::size_t bytes_ = 0;
+  bool good_ = true;
+};
+
+template<std::size_t Capacity = 64>
+using gather_writer = basic_gather_writer<char, Capacity>;
+
+template<std::size_t Capacity = 64>
+using wgather_writer = basic_gather_writer<wchar_t, Capacity>;
+
+
+template<class CharT, class Traits, std::size_t Capacity>
+std::basic_ostream<CharT, Traits> &
+ostream_write(
+  std::basic_ostream<CharT, Traits> & out
+, basic_gather_writer<CharT, Capacity> const & writer)
+{ return writer.write_to(out); }
+
+} }
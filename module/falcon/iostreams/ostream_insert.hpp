@@ -26,6 +26,7 @@ SOFTWARE.
 #include <falcon/cxx/string_view.hpp>
 
 #include <iosfwd>
+#include <algorithm>
 #include <cstddef>
 
 
@@ -78,7 +79,7 @@ std::basic_ostream<CharT, Traits>&
 ostream_write(
   std::basic_ostream<CharT, Traits> & out
 , FALCON_STD_STRING_VIEW<CharT, Traits> const & str)
-{ return ostream_write(out, str.data(), str.size()); }}
+{ return ostream_write(out, str.data(), str.size()); }
 
 template<class CharT, class Traits>
 std::basic_ostream<CharT, Traits>&
@@ -91,17 +92,34 @@ ostream_insert(
 
 namespace detail_
 {
+  /// Below, a padding is written character by character.
+  constexpr std::streamsize ostream_fill_min_block = 8;
+  /// Maximal number of characters written by one sputn.
+  constexpr std::streamsize ostream_fill_block_size = 64;
+
   template <class CharT, class Traits>
   inline bool ostream_fill(
     std::basic_streambuf<CharT, Traits> & buf,
     std::streamsize n, CharT fill)
   {
-    for (std::streamsize i = 0; i < n; ++i) {
-      if (Traits::eq_int_type(buf.sputc(fill), Traits::eof())) {
+    if (n < ostream_fill_min_block) {
+      for (std::streamsize i = 0; i < n; ++i) {
+        if (Traits::eq_int_type(buf.sputc(fill), Traits::eof())) {
+          return false;
+        }
+      }
+      return true;
+    }
+
+    CharT block[ostream_fill_block_size];
+    std::streamsize const len = std::min(n, ostream_fill_block_size);
+    Traits::assign(block, static_cast<std::size_t>(len), fill);
+    for (; n > len; n -= len) {
+      if (buf.sputn(block, len) != len) {
         return false;
       }
     }
-    return true;
+    return buf.sputn(block, n) == n;
   }
 }
 
@@ -115,7 +133,7 @@ ostream_fill(
   using ios_base = typename ostream_type::ios_base;
 
   if (typename ostream_type::sentry cerb{out}) {
-    if (!detail_::ostream_fill(out.rdbuf(), n, fill)) {
+    if (!detail_::ostream_fill(*out.rdbuf(), n, fill)) {
       out.setstate(ios_base::failbit);
     }
   }
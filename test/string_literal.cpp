@@ -27,10 +27,32 @@ SOFTWARE.
 */
 
 #include "falcon/container/string_literal.hpp"
+#include "falcon/container/string_literal_searcher.hpp"
+#include "falcon/container/string_literal_charset.hpp"
+#include "falcon/container/string_literal_matcher.hpp"
+#include "falcon/container/hashed_string_literal.hpp"
+#include "falcon/container/string_literal_map.hpp"
+#include "falcon/container/string_literal_format.hpp"
+#include "falcon/container/string_literal_floating.hpp"
+#include "falcon/container/string_literal_parse.hpp"
+#include "falcon/container/string_literal_pool.hpp"
+#include "falcon/container/string_literal_ref.hpp"
+#include "falcon/container/aligned_string_literal.hpp"
+#include "falcon/container/string_literal_transcode.hpp"
+#include "falcon/container/string_literal_case.hpp"
 #include "falcon/string_id.hpp"
+#include "falcon/string_switch.hpp"
+#include "falcon/deferred_log.hpp"
+#include "falcon/iostreams/gather_writer.hpp"
 
 #include <sstream>
 #include <iomanip>
+#include <algorithm>
+#include <unordered_set>
+#include <cstdio>
+#include <cstring>
+#include <cstdlib>
+#include <limits>
 
 #ifndef __cpp_exceptions
 # include <cstdlib>
@@ -41,6 +63,9 @@ using namespace falcon::make_string_literal_shortcut;
 using falcon::to_string_literal_i;
 using falcon::to_string_literal_u;
 using falcon::string_literal;
+using falcon::make_string_literal_searcher;
+using falcon::make_string_literal_charset;
+using falcon::make_string_literal_matcher;
 
 constexpr char const s1[] = "abc";
 constexpr char const s2[] = "def";
@@ -52,6 +77,36 @@ constexpr string_literal<9> s7 = s3 + "abc";
 constexpr string_literal<0> s9 = lit("");
 constexpr string_literal<1> s10 = lit("a");
 constexpr string_literal<3> abc = lit("abc");
+constexpr std::size_t brace_pos = lit("ab{").find('{');
+constexpr auto status_line = falcon::make_string_literal_format(
+  lit("HTTP/1.1 {} {}\r\n"));
+
+constexpr auto big_pool = falcon::make_string_literal_pool(
+  lit("error"), lit("io error"), lit("error"), lit("or"), lit(""), lit("warning"));
+constexpr auto pool = big_pool.shrink<big_pool.size()>();
+
+constexpr falcon::literal_ref<6> s3_ref = s3;
+constexpr auto s3_ref_sub = s3_ref.substr<1, 3>();
+
+constexpr auto al_options = falcon::make_aligned_string_literal<32>("OPTIONS");
+constexpr auto al_wide = falcon::make_aligned_string_literal<16>(lit(L"OPTIONS"));
+
+constexpr auto utf8_cafe = lit(u8"caf\u00e9 \U0001F600");
+struct utf8_path { static constexpr auto value = lit(u8"C:\\caf\u00e9"); };
+using utf8_char = decltype(utf8_cafe)::value_type;
+constexpr char16_t utf16_unpaired[] {u'a', char16_t(0xD800), u'b', 0};
+
+constexpr auto ci_content_length = ci_lit("Content-Length");
+
+struct fp_pi { static constexpr double value = 3.141592653589793; };
+struct fp_tenth { static constexpr double value = 0.1; };
+struct fp_neg { static constexpr double value = -2.5e-8; };
+struct fp_big { static constexpr double value = 1e22; };
+struct fp_pow63 { static constexpr double value = 9223372036854775808.0; };
+struct fp_denorm_min { static constexpr double value = 5e-324; };
+struct fp_max { static constexpr double value = 1.7976931348623157e308; };
+struct fp_float { static constexpr float value = 0.3f; };
+struct fp_inf { static constexpr double value = std::numeric_limits<double>::infinity(); };
 
 template<std::size_t i>
 class u_ {};
@@ -87,6 +142,165 @@ constexpr bool operator == (i_<i>, i_<i>)
 #endif
 }
 
+template<std::size_t N>
+void check_aligned_string_literal()
+{
+  char buf[N + 1] {};
+  for (std::size_t i = 0; i < N; ++i) {
+    buf[i] = char('a' + i % 7);
+  }
+  auto const str = falcon::make_string_literal(buf);
+  auto const al = falcon::make_aligned_string_literal<64>(str);
+  auto const al2 = falcon::make_aligned_string_literal<64>(str);
+  std::string const ref(buf, N);
+
+  if (reinterpret_cast<std::uintptr_t>(al.data()) % 64 || !(al == al2) || al != str) {
+    throw_runtime_error("bad aligned_string_literal");
+  }
+  for (char c : {'a', 'c', 'g', 'z', '\0'}) {
+    for (std::size_t pos = 0; pos <= N; ++pos) {
+      if (al.find(c, pos) != ref.find(c, pos) || al.rfind(c, pos) != ref.rfind(c, pos)) {
+        throw_runtime_error("bad aligned_string_literal::find");
+      }
+    }
+    if (al.rfind(c, N + 1) != ref.rfind(c, N + 1)) {
+      throw_runtime_error("bad aligned_string_literal::rfind");
+    }
+  }
+#ifdef __cpp_exceptions
+  bool out_of_range = false;
+  try {
+    (void)al.find('a', N + 1);
+  }
+  catch (std::out_of_range const &) {
+    out_of_range = true;
+  }
+  if (!out_of_range) {
+    throw_runtime_error("bad aligned_string_literal::find");
+  }
+#endif
+  if (al.rfind('a') != ref.rfind('a')) {
+    throw_runtime_error("bad aligned_string_literal::rfind");
+  }
+  if (N) {
+    buf[N - 1] = 'z';
+    auto const other = falcon::make_aligned_string_literal<64>(
+      falcon::make_string_literal(buf));
+    if (al == other) {
+      throw_runtime_error("bad aligned_string_literal::operator==");
+    }
+  }
+}
+
+template<std::size_t N>
+void check_literal_compare()
+{
+  // word and vector comparisons, with a difference at each position
+  char a[N + 1] {};
+  char b[N + 1] {};
+  for (std::size_t i = 0; i < N; ++i) {
+    a[i] = b[i] = char('0' + i % 37);
+  }
+  auto const x = falcon::make_string_literal(a);
+  if (!(x == falcon::make_string_literal(b)) || x.compare(falcon::make_string_literal(b))) {
+    throw_runtime_error("bad string_literal::operator==");
+  }
+  for (std::size_t i = 0; i < N; ++i) {
+    b[i] = '\xff';
+    auto const y = falcon::make_string_literal(b);
+    if (x == y || !(x != y) || !(x < y)
+     || x.compare(y) >= 0 || y.compare(x) <= 0
+     || x.compare(0, i, y, 0, i) != 0 || x.compare(0, i + 1, y, 0, i + 1) >= 0) {
+      throw_runtime_error("bad string_literal::compare");
+    }
+    b[i] = a[i];
+  }
+}
+
+template<std::size_t... Ns>
+void check_literal_compare(std::index_sequence<Ns...>)
+{ (void)std::initializer_list<int>{(check_literal_compare<Ns>(), 0)...}; }
+
+/// Runtime path of parse_int, parse_uint and parse_hex on \a N digits
+/// (8 digits at a time).
+template<std::size_t N>
+void check_parse_integer()
+{
+  unsigned long long max_value = ~0ull;
+  if (N < 20) {
+    max_value = 1;
+    for (std::size_t i = 0; i < N; ++i) {
+      max_value *= 10;
+    }
+  }
+
+  char str[N + 1] {};
+  char neg[N + 2] {};
+  char hex[N + 1] {};
+  unsigned long long x = N;
+  for (std::size_t i = 0; i < 1000; ++i) {
+    x = x * 6364136223846793005ull + 1442695040888963407ull;
+    unsigned long long const v = (x >> (i % 64)) % (N < 20 ? max_value : ~0ull);
+    char buf[32];
+    std::snprintf(buf, sizeof(buf), "%0*llu", int(N), v);
+    std::memcpy(str, buf, N);
+    std::memcpy(neg + 1, buf, N);
+    neg[0] = '-';
+    std::snprintf(buf, sizeof(buf), "%0*llx", int(N), v);
+    std::memcpy(hex, buf, N);
+
+    auto const u = falcon::parse_uint<unsigned long long>(falcon::make_string_literal(str));
+    auto const i64 = falcon::parse_int<long long>(falcon::make_string_literal(str));
+    auto const n64 = falcon::parse_int<long long>(falcon::make_string_literal(neg));
+    auto const u32 = falcon::parse_uint<std::uint32_t>(falcon::make_string_literal(str));
+    auto const h = falcon::parse_hex<unsigned long long>(falcon::make_string_literal(hex));
+    bool const fits_i64 = v <= 9223372036854775807ull;
+    if (!u || *u != v
+     || bool(i64) != fits_i64 || (i64 && *i64 != static_cast<long long>(v))
+     || bool(n64) != (v <= 9223372036854775808ull)
+     || (n64 && fits_i64 && *n64 != -static_cast<long long>(v))
+     || bool(u32) != (v <= 0xffffffffu) || (u32 && *u32 != v)
+     || !h || *h != v) {
+      throw_runtime_error("bad parse_uint");
+    }
+    if (!u32 && u32.error() != std::errc::result_out_of_range) {
+      throw_runtime_error("bad parse_uint");
+    }
+
+    str[i % N] = (i & 1) ? ':' : '/';
+    auto const bad = falcon::parse_uint<unsigned long long>(falcon::make_string_literal(str));
+    if (bad || bad.error_position() != i % N) {
+      throw_runtime_error("bad parse_uint");
+    }
+  }
+}
+
+template<std::size_t... Ns>
+void check_parse_integer(std::index_sequence<Ns...>)
+{ (void)std::initializer_list<int>{(check_parse_integer<Ns + 1>(), 0)...}; }
+
+#ifdef __cpp_exceptions
+template<class To, class Ch, std::size_t N>
+bool is_invalid_utf(falcon::basic_string_literal<Ch, N> const & str)
+{
+  try {
+    falcon::transcoded_size<To>(str);
+  }
+  catch (std::invalid_argument const &) {
+    return true;
+  }
+  return false;
+}
+#endif
+
+/// \a c (one code point) converted to \a M code units of \a To, then back.
+template<class To, std::size_t M>
+bool utf_round_trip(falcon::basic_string_literal<char32_t, 1> const & c)
+{
+  return falcon::transcoded_size<To>(c) == M
+    && falcon::transcode<char32_t, 1>(falcon::transcode<To, M>(c)) == c;
+}
+
 inline void check()
 {
   u_<0> u0;
@@ -140,10 +354,51 @@ inline void check()
 
   static_assert(lit("defdef") == s4.substr<s4.find('d')>(), "");
 
+  static_assert(lit("abcdefdefabc") == falcon::concat(s3, lit("def"), abc), "");
+  static_assert(lit("abc") == falcon::concat(abc), "");
+  static_assert(lit("abcabc") == falcon::concat(abc, s9, abc), "");
+  static_assert(lit("abc, def, abc") == falcon::join(lit(", "), abc, lit("def"), abc), "");
+  static_assert(lit("abc") == falcon::join(lit(", "), abc), "");
+  static_assert(lit("") == falcon::join(lit(", ")), "");
+  static_assert(lit("a-b-") == falcon::join(lit("-"), lit("a"), lit("b"), s9), "");
+
   static_assert(lit("42") != lit("42\0"), "");
   static_assert(lit("42") == lit("42"), "");
   static_assert(lit("42") == to_string_literal_i<42>(), "");
   static_assert(lit("-42") == to_string_literal_i<-42>(), "");
+  static_assert(lit("-9223372036854775808")
+    == to_string_literal_i<-9223372036854775807LL-1>(), "");
+  static_assert(lit("0") == falcon::to_string_literal_hex<0>(), "");
+  static_assert(lit("ff") == falcon::to_string_literal_hex<255>(), "");
+  static_assert(lit("000000ff") == falcon::to_string_literal_hex<255, 8>(), "");
+  static_assert(lit("ffffffffffffffff")
+    == falcon::to_string_literal_hex<~0ull>(), "");
+  static_assert(lit("17") == falcon::to_string_literal_oct<15>(), "");
+  static_assert(lit("101") == falcon::to_string_literal_bin<5, 2>(), "");
+  static_assert(lit("00000101") == falcon::to_string_literal_bin<5, 8>(), "");
+  static_assert(lit("-00042")
+    == falcon::to_basic_string_literal_base<char, 10, int, -42, 6>(), "");
+  static_assert(lit("-z") == falcon::to_basic_string_literal_base<char, 36, int, -35>(), "");
+  static_assert(lit(L"2a") == falcon::to_wstring_literal_hex<42>(), "");
+  static_assert(lit(L"42") == falcon::to_wstring_literal_u<42>(), "");
+
+  static_assert(lit("3.141592653589793") == falcon::to_string_literal_f<fp_pi>(), "");
+  static_assert(lit("0.1") == falcon::to_string_literal_f<fp_tenth>(), "");
+  static_assert(lit("-2.5e-08") == falcon::to_string_literal_f<fp_neg>(), "");
+  static_assert(lit("1e+22") == falcon::to_string_literal_f<fp_big>(), "");
+  static_assert(lit("9223372036854775808") == falcon::to_string_literal_f<fp_pow63>(), "");
+  static_assert(lit("5e-324") == falcon::to_string_literal_f<fp_denorm_min>(), "");
+  static_assert(lit("1.7976931348623157e+308") == falcon::to_string_literal_f<fp_max>(), "");
+  static_assert(lit("0.3") == falcon::to_string_literal_f<fp_float>(), "");
+  static_assert(lit("inf") == falcon::to_string_literal_f<fp_inf>(), "");
+  static_assert(lit(L"0.1") == falcon::to_wstring_literal_f<fp_tenth>(), "");
+#if defined(__cpp_nontype_template_args) && __cpp_nontype_template_args >= 201911L
+  static_assert(lit("-0") == falcon::to_string_literal_f<-0.0>(), "");
+  static_assert(lit("100") == falcon::to_string_literal_f<100.0>(), "");
+  static_assert(lit("1e-05") == falcon::to_string_literal_f<1e-5f>(), "");
+#endif
+  static_assert(falcon::integer_size<16>(0x12345u) == 5, "");
+  static_assert(falcon::integer_size<10>(-1, 4) == 4, "");
 
   {
     char s[] = "abcdef";
@@ -164,28 +419,368 @@ inline void check()
     }
   }
   {
-    char s[6]{};
-    if (4 == s3.copy(s, 4)) {
+    char s[7]{};
+    if (4 != s3.copy(s, 4)) {
         throw_runtime_error("bad copy");
     }
-    if (0 == strcmp(s, "abcd")) {
+    if (0 != strcmp(s, "abcd")) {
         throw_runtime_error("bad copy");
     }
-    if (6 == s3.copy(s, 6)) {
+    if (6 != s3.copy(s, 7)) {
         throw_runtime_error("bad copy");
     }
-    if (0 == strcmp(s, "abcdef")) {
+    if (0 != strcmp(s, "abcdef")) {
         throw_runtime_error("bad copy");
     }
     s[0] = s[1] = s[2] = s[3] = s[4] = s[5] = 0;
-    if (4 == s3.copy(s, 4, 1)) {
+    if (4 != s3.copy(s, 4, 1)) {
         throw_runtime_error("bad copy");
     }
-    if (0 == strcmp(s, "bcde")) {
+    if (0 != strcmp(s, "bcde")) {
         throw_runtime_error("bad copy");
     }
   }
 
+  {
+    // runtime write_integer against printf
+    auto check = [](unsigned long long x, int w) {
+      char expected[80];
+      char result[80];
+      auto const uw = std::size_t(w);
+      int n = std::snprintf(expected, sizeof(expected), "%0*llu", w, x);
+      if (falcon::write_integer<10>(result, x, uw) - result != n
+       || std::memcmp(expected, result, std::size_t(n))) {
+        throw_runtime_error("bad write_integer<10>");
+      }
+      n = std::snprintf(expected, sizeof(expected), "%0*llx", w, x);
+      if (falcon::write_integer<16>(result, x, uw) - result != n
+       || std::memcmp(expected, result, std::size_t(n))) {
+        throw_runtime_error("bad write_integer<16>");
+      }
+      n = std::snprintf(expected, sizeof(expected), "%0*llo", w, x);
+      if (falcon::write_integer<8>(result, x, uw) - result != n
+       || std::memcmp(expected, result, std::size_t(n))) {
+        throw_runtime_error("bad write_integer<8>");
+      }
+    };
+
+    unsigned long long x = 1;
+    for (int i = 0; i < 2000; ++i) {
+      x = x * 6364136223846793005ull + 1442695040888963407ull;
+      check(x >> (i % 64), i % 24);
+    }
+    for (unsigned long long v : {0ull, 9ull, 10ull, 99ull, 100ull, 255ull, 256ull, ~0ull}) {
+      check(v, 0);
+    }
+
+    char buf[40];
+    long long const values[] {0, -1, -9, -10, 42, -9223372036854775807LL-1};
+    for (long long v : values) {
+      char expected[40];
+      int const n = std::snprintf(expected, sizeof(expected), "%08lld", v);
+      if (falcon::write_integer(buf, v, 8) - buf != n
+       || std::memcmp(buf, expected, std::size_t(n))) {
+        throw_runtime_error("bad write_integer");
+      }
+    }
+    std::uint8_t const u8 = 200;
+    std::int8_t const i8 = -128;
+    if (falcon::write_integer<2>(buf, u8) - buf != 8 || std::memcmp(buf, "11001000", 8)
+     || falcon::write_integer(buf, i8) - buf != 4 || std::memcmp(buf, "-128", 4)
+     || falcon::write_integer(buf, true) - buf != 1 || buf[0] != '1') {
+      throw_runtime_error("bad write_integer");
+    }
+  }
+
+  static_assert(falcon::parse_int(lit("8080")).value() == 8080, "");
+  static_assert(falcon::parse_int(lit("-2147483648")).value() == -2147483647-1, "");
+  static_assert(falcon::parse_int<signed char>(lit("-129")).error()
+    == std::errc::result_out_of_range, "");
+  static_assert(falcon::parse_int(lit("12a")).error() == std::errc::invalid_argument, "");
+  static_assert(falcon::parse_int(lit("12a")).error_position() == 2, "");
+  static_assert(falcon::parse_int(lit("-")).error_position() == 1, "");
+  static_assert(falcon::parse_int(lit("+1")).error_position() == 0, "");
+  static_assert(!falcon::parse_uint(lit("")), "");
+  static_assert(!falcon::parse_uint(lit("-1")), "");
+  static_assert(falcon::parse_uint<unsigned long long>(lit("18446744073709551615")).value()
+    == ~0ull, "");
+  static_assert(!falcon::parse_uint<unsigned long long>(lit("18446744073709551616")), "");
+  static_assert(falcon::parse_uint<std::uint8_t>(lit("0000000000000255")).value() == 255, "");
+  static_assert(falcon::parse_hex(lit("0xFFff")).value() == 0xffff, "");
+  static_assert(falcon::parse_hex(lit("dead")).value() == 0xdead, "");
+  static_assert(!falcon::parse_hex(lit("0x")), "");
+  static_assert(falcon::parse_hex(lit("0x1g")).error_position() == 3, "");
+  static_assert(falcon::parse_int(lit(L"-42")).value_or(0) == -42, "");
+
+  static_assert(big_pool.capacity() == 33, "");
+  static_assert(pool.capacity() == 17, "");
+  static_assert(pool.size() == 17, "");
+  static_assert(pool.count() == 6, "");
+  static_assert(pool.handle(1).offset == 0 && pool.handle(1).size == 8, "");
+  static_assert(pool.handle(0).offset == 3 && pool.handle(0).size == 5, "");
+  static_assert(pool.handle(2).offset == 3 && pool.handle(3).offset == 6, "");
+  static_assert(pool.size(4) == 0 && pool.size(5) == 7, "");
+  static_assert(pool.c_str(std::size_t(5))[0] == 'w', "");
+
+  static_assert(sizeof(s3_ref) == sizeof(char const *), "");
+  static_assert(std::is_trivially_copyable<falcon::literal_ref<6>>::value, "");
+  static_assert(!std::is_constructible<
+    falcon::literal_ref<3>, falcon::string_literal<3>>::value, "");
+  static_assert(s3_ref.size() == 6 && s3_ref.data() == s3.data(), "");
+  static_assert(s3_ref == s3 && s3 == s3_ref && s3_ref == "abcdef", "");
+  static_assert(s3_ref_sub.size() == 3 && s3_ref_sub == lit("bcd"), "");
+  static_assert(s3_ref_sub != s3_ref && s3_ref < s3_ref_sub, "");
+  static_assert(s3_ref_sub.substr<1>() == "cd", "");
+  static_assert(s3_ref_sub.str() == lit("bcd"), "");
+  static_assert(s3_ref.find('d') == 3 && s3_ref.find('d', 6) == s3_ref.npos, "");
+  static_assert(s3_ref.find(lit("cd")) == 2 && s3_ref.rfind("c") == 2, "");
+  static_assert(s3_ref.find(s3_ref_sub) == 1, "");
+  static_assert(s3_ref_sub.find("d") == 2 && s3_ref_sub.find("e") == s3_ref.npos, "");
+  static_assert(s3_ref.find_first_of("fd") == 3 && s3_ref.find_last_of("ad") == 3, "");
+  static_assert(s3_ref.find_first_not_of("ab") == 2, "");
+  static_assert(s3_ref.find_last_not_of('f') == 4, "");
+  static_assert(s3_ref.find(make_string_literal_searcher(lit("de"))) == 3, "");
+  static_assert(s3_ref.find_first_of(make_string_literal_charset(lit("ec"))) == 2, "");
+  static_assert(s3_ref_sub.compare(s3_ref) > 0 && s3_ref.compare("abcdef") == 0, "");
+  static_assert(s3_ref.compare(1, 2, "bc") == 0 && s3_ref.compare(1, 2, "bcx", 2) == 0, "");
+  static_assert(s3_ref.compare(1, 3, lit("bcd")) == 0 && s3_ref.compare(1, 9, s3_ref_sub) > 0, "");
+  static_assert(s3_ref.compare(0, 1, s3_ref_sub, 2, 1) < 0, "");
+  static_assert(s3_ref.compare(3, 1, lit("abcd"), 3, 5) == 0, "");
+  static_assert(s3_ref < lit("b") && lit("b") > s3_ref && s3_ref <= s3 && s3 >= s3_ref, "");
+  static_assert(s3_ref < "b" && "b" > s3_ref && !(s3_ref_sub <= "b") && "b" <= s3_ref_sub, "");
+  static_assert(s3_ref.max_size() == s3.max_size(), "");
+
+  static_assert(sizeof(al_options) == 32 && alignof(decltype(al_options)) == 32, "");
+  static_assert(sizeof(al_wide) == 32 || sizeof(al_wide) == 64, "");
+  static_assert(al_options.size() == 7 && al_options.padded_size() == 32, "");
+  static_assert(al_options.max_size() == lit("OPTIONS").max_size(), "");
+  static_assert(al_options[31] == '\0' && *al_options.end() == '\0', "");
+  static_assert(al_options == lit("OPTIONS") && al_options != lit("OPTION"), "");
+  static_assert(al_options == al_options && al_options.str() == lit("OPTIONS"), "");
+  static_assert(al_options.find('T') == 2 && al_options.rfind('O') == 4, "");
+  static_assert(al_options.find('\0') == al_options.npos, "");
+  static_assert(al_options.find(lit("ON")) == 4 && al_options.compare("OPTIONS") == 0, "");
+  static_assert(al_wide.find(L'S') == 6 && al_wide == lit(L"OPTIONS"), "");
+
+  {
+    check_literal_compare(std::make_index_sequence<81>{});
+
+    char a[42] {};
+    char b[41] {};
+    for (std::size_t i = 0; i < 40; ++i) {
+      a[i] = b[i] = char('0' + i % 37);
+    }
+    a[40] = '0';
+    auto const y = falcon::make_string_literal(a);
+    auto const x = y.substr<0, 40>();
+    auto const w = falcon::make_string_literal(b);
+    if (!(x == w) || x == y || x.compare(y) >= 0 || y.compare(x) <= 0 || x.compare(w)
+     || !(x < y) || !(falcon::literal_ref<40>(x) == w) || falcon::literal_ref<41>(y) == x) {
+      throw_runtime_error("bad string_literal::compare");
+    }
+#ifdef __cpp_exceptions
+    bool out_of_range = false;
+    try {
+      falcon::literal_ref<40>(x).compare(41, 1, "a");
+    }
+    catch (std::out_of_range const &) {
+      out_of_range = true;
+    }
+    if (!out_of_range) {
+      throw_runtime_error("bad literal_ref::compare");
+    }
+
+    std::size_t find_out_of_range = 0;
+    try {
+      (void)x.find('0', 41);
+    }
+    catch (std::out_of_range const &) {
+      ++find_out_of_range;
+    }
+    try {
+      (void)falcon::literal_ref<40>(x).find('0', 41);
+    }
+    catch (std::out_of_range const &) {
+      ++find_out_of_range;
+    }
+    if (find_out_of_range != 2) {
+      throw_runtime_error("bad literal_ref::find");
+    }
+#endif
+    auto const wx = lit(L"abcdefghijklmnop");
+    auto wy = wx;
+    if (!(wx == wy) || wx.compare(lit(L"abcdefghijklmnoq")) >= 0) {
+      throw_runtime_error("bad wstring_literal::compare");
+    }
+  }
+
+  static_assert(utf8_cafe.size() == 10, "");
+  static_assert(falcon::transcoded_size<char16_t>(utf8_cafe) == 7, "");
+  static_assert(falcon::transcoded_size<char32_t>(utf8_cafe) == 6, "");
+  static_assert(falcon::transcode<char16_t, 7>(utf8_cafe) == lit(u"caf\u00e9 \U0001F600"), "");
+  static_assert(falcon::transcode<char32_t, 6>(utf8_cafe) == lit(U"caf\u00e9 \U0001F600"), "");
+  static_assert(falcon::transcode<utf8_char, 10>(lit(u"caf\u00e9 \U0001F600")) == utf8_cafe, "");
+  static_assert(falcon::transcode<char16_t, 2>(lit(U"\U0010FFFF"))[0] == 0xDBFF, "");
+  static_assert(falcon::transcode<wchar_t, utf8_path>() == lit(L"C:\\caf\u00e9"), "");
+  static_assert(falcon::transcode<char32_t, utf8_path>().size() == 7, "");
+#if defined(__cpp_nontype_template_args) && __cpp_nontype_template_args >= 201411L
+  static_assert(falcon::transcode<char16_t, utf8_cafe>() == lit(u"caf\u00e9 \U0001F600"), "");
+#endif
+#ifdef __cpp_exceptions
+  // overlong, surrogate, beyond U+10FFFF, truncated and unpaired
+  if (!is_invalid_utf<char16_t>(lit("a\xC0\x80"))
+   || !is_invalid_utf<char16_t>(lit("\xED\xA0\x80"))
+   || !is_invalid_utf<char16_t>(lit("\xF4\x90\x80\x80"))
+   || !is_invalid_utf<char16_t>(lit("ab\xE2\x82"))
+   || !is_invalid_utf<char>(lit(utf16_unpaired))
+   || !is_invalid_utf<char>(lit(U"\x110000"))
+   || is_invalid_utf<char>(lit(U"\x10FFFF"))) {
+    throw_runtime_error("bad transcoded_size");
+  }
+#endif
+
+  {
+    // every code point through UTF-8 and UTF-16
+    for (std::uint32_t cp = 0; cp <= 0x10FFFF; ++cp) {
+      if (cp == 0xD800) {
+        cp = 0xE000;
+      }
+      auto const c = falcon::make_string_literal<1>(char32_t(cp));
+      bool const u8_ok
+        = cp < 0x80 ? utf_round_trip<char, 1>(c)
+        : cp < 0x800 ? utf_round_trip<char, 2>(c)
+        : cp < 0x10000 ? utf_round_trip<char, 3>(c)
+        : utf_round_trip<char, 4>(c);
+      bool const u16_ok = cp < 0x10000
+        ? utf_round_trip<char16_t, 1>(c)
+        : utf_round_trip<char16_t, 2>(c);
+      if (!u8_ok || !u16_ok) {
+        throw_runtime_error("bad transcode");
+      }
+    }
+  }
+
+  static_assert(falcon::to_lower(lit("Content-Length: 42")) == lit("content-length: 42"), "");
+  static_assert(falcon::to_upper(lit(L"gzip, Br")) == lit(L"GZIP, BR"), "");
+  static_assert(falcon::to_lower(lit("\xC9[@Z`")) == lit("\xC9[@z`"), "");
+  static_assert(ci_content_length == ci_lit("content-LENGTH"), "");
+  static_assert(ci_content_length != ci_lit("content-type"), "");
+  static_assert(ci_content_length.compare("CONTENT-LENGTH") == 0, "");
+  static_assert(ci_lit("a") < ci_lit("B") && ci_lit("[") < ci_lit("z") && ci_lit("{") > ci_lit("Z"), "");
+  static_assert(ci_content_length.find('l') == 8 && ci_content_length.find("LENGTH") == 8, "");
+  static_assert(ci_content_length.find(make_string_literal_searcher(ci_lit("LeNgTh"))) == 8, "");
+  static_assert(ci_content_length.find_first_of(ci_lit("T")) == 3, "");
+  static_assert(falcon::to_std_string_literal(ci_content_length) == lit("Content-Length"), "");
+  static_assert(falcon::to_ci_string_literal(lit("ETag")) == ci_lit("etag"), "");
+  static_assert(std::hash<falcon::ci_string_literal<4>>{}(ci_lit("ETAG"))
+             == std::hash<falcon::ci_string_literal<4>>{}(ci_lit("etag")), "");
+
+  {
+    // runtime case-insensitive comparisons against a scalar reference
+    using ci_traits = falcon::ci_char_traits<char>;
+    char const chars[] = "aAzZ@[`{-0\xC1\xE1";
+    char const lower_chars[] = "aazz@[`{-0\xC1\xE1";
+    char const upper_chars[] = "AAZZ@[`{-0\xC1\xE1";
+    char a[81] {};
+    char b[81] {};
+    unsigned long long x = 1;
+    for (int iter = 0; iter < 2000; ++iter) {
+      std::size_t const n = std::size_t(iter) % (sizeof(a) - 1);
+      for (std::size_t i = 0; i < n; ++i) {
+        x = x * 6364136223846793005ull + 1442695040888963407ull;
+        std::size_t const k = (x >> 33) % 12;
+        a[i] = chars[k];
+        b[i] = (x >> 40) & 1 ? upper_chars[k] : lower_chars[k];
+      }
+      if (n && (x >> 50) & 1) {
+        b[(x >> 20) % n] = chars[(x >> 12) % 12];
+      }
+      std::size_t expected = n;
+      for (std::size_t i = 0; i < n; ++i) {
+        if (!ci_traits::eq(a[i], b[i])) {
+          expected = i;
+          break;
+        }
+      }
+
+      auto const ci_a = falcon::make_string_literal<char, ci_traits>(a);
+      int const r = ci_traits::compare(a, b, n);
+      if (ci_a.compare(0, n, b, n) != r
+       || ci_a.compare(0, expected, b, expected) != 0
+       || (expected < n && ci_a.compare(0, expected + 1, b, expected + 1) != r)) {
+        throw_runtime_error("bad ci_string_literal::compare");
+      }
+      // in the last n characters
+      std::size_t const tail = ci_a.size() - n;
+      for (char c : {'a', 'Z', '[', '\xE1'}) {
+        char const * p = ci_traits::find(a + tail, n, c);
+        if (ci_a.find(c, tail) != (p ? std::size_t(p - a) : ci_a.npos)) {
+          throw_runtime_error("bad ci_string_literal::find");
+        }
+      }
+    }
+
+    auto const header = std::string("content-length");
+    char header_chars[15] {};
+    header.copy(header_chars, 14);
+    if (ci_content_length.compare(0, 14, header.c_str(), header.size()) != 0
+     || !(ci_content_length == falcon::to_ci_string_literal(
+       falcon::make_string_literal(header_chars)))
+     || ci_content_length.find('E') != 4) {
+      throw_runtime_error("bad ci_string_literal");
+    }
+  }
+
+  check_aligned_string_literal<0>();
+  check_aligned_string_literal<1>();
+  check_aligned_string_literal<15>();
+  check_aligned_string_literal<16>();
+  check_aligned_string_literal<31>();
+  check_aligned_string_literal<32>();
+  check_aligned_string_literal<33>();
+  check_aligned_string_literal<63>();
+  check_aligned_string_literal<64>();
+  check_aligned_string_literal<100>();
+
+  {
+    // shortest representation read back with strtod
+    unsigned long long x = 1;
+    for (int i = 0; i < 20000; ++i) {
+      x = x * 6364136223846793005ull + 1442695040888963407ull;
+      double v;
+      std::memcpy(&v, &x, sizeof(v));
+      if (!(v < 0 || v > 0)) {
+        // NaN and zero
+        continue;
+      }
+      auto const chars = falcon::detail_::fp_to_chars(v);
+      char str[40]{};
+      std::memcpy(str, chars.data, chars.size);
+      double const r = std::strtod(str, nullptr);
+      if (std::memcmp(&r, &v, sizeof(v))) {
+        throw_runtime_error("bad fp_to_chars");
+      }
+      if (chars.size > 24) {
+        throw_runtime_error("fp_to_chars is not the shortest");
+      }
+    }
+  }
+
+  check_parse_integer(std::make_index_sequence<20>{});
+
+  {
+    char const * expected[] {"error", "io error", "error", "or", "", "warning"};
+    for (std::size_t i = 0; i < pool.count(); ++i) {
+      if (std::strcmp(pool.c_str(i), expected[i])
+       || pool.size(i) != std::strlen(expected[i])) {
+        throw_runtime_error("bad string_literal_pool");
+      }
+    }
+    if (std::memcmp(pool.data(), "io error\0warning", 17)) {
+      throw_runtime_error("bad string_literal_pool");
+    }
+  }
+
   i_<0> i0;
 
   i_<s3.compare(s3)>{} = i0;
@@ -250,6 +845,24 @@ inline void check()
   u_<s7.find("ax", 7, 1)>{} = npos;
 
 
+  constexpr auto abc_searcher = make_string_literal_searcher(abc);
+  constexpr auto e_searcher = make_string_literal_searcher(s9);
+
+  u_<s7.find(abc_searcher)>{} = u_<0>{};
+  u_<s7.find(abc_searcher, 1)>{} = u_<6>{};
+  u_<s7.find(abc_searcher, 7)>{} = npos;
+  u_<s7.find(e_searcher, 3)>{} = u_<3>{};
+  u_<s7.find(e_searcher, 10)>{} = npos;
+  u_<s3.find(make_string_literal_searcher(lit("def")))>{} = u_<3>{};
+  u_<s3.find(make_string_literal_searcher(lit("abcdefg")))>{} = npos;
+
+  u_<s7.rfind(abc_searcher)>{} = u_<6>{};
+  u_<s7.rfind(abc_searcher, 5)>{} = u_<0>{};
+  u_<s7.rfind(abc_searcher, 0)>{} = u_<0>{};
+  u_<s7.rfind(e_searcher, 4)>{} = u_<4>{};
+  u_<s7.rfind(e_searcher)>{} = u_<9>{};
+  u_<s3.rfind(make_string_literal_searcher(lit("bc")))>{} = u_<1>{};
+
   u_<s7.rfind('a')>{} = u_<6>{};
   u_<s7.rfind('b')>{} = u_<7>{};
   u_<s7.rfind('c')>{} = u_<8>{};
@@ -298,6 +911,457 @@ inline void check()
   u_<s7.find_last_not_of("abcd", 7)>{} = u_<5>{};
   u_<s7.find_last_not_of("abcd", 3, 4)>{} = npos;
 
+  {
+    // runtime path of find_ and rfind_ (vectorized when available)
+    auto const hay = lit<70>('a') + abc + lit<100>('a') + "abcab" + lit<40>('b')
+      + abc + lit<3>('c');
+    std::string const shay = hay.to_string();
+    char const * needles[] = {
+      "a", "c", "ab", "abc", "ca", "aab", "bbbbbabc", "abca", "x", "abcx",
+      "bcab", "aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa",
+    };
+    constexpr auto searcher = make_string_literal_searcher(lit("abcab"));
+    constexpr auto bsearcher = make_string_literal_searcher(lit<20>('b'));
+    auto const r = searcher(shay.begin(), shay.end());
+    if (r.first - shay.begin() != 173 || r.second - r.first != 5) {
+      throw_runtime_error("bad searcher");
+    }
+    for (std::size_t pos = 0; pos <= hay.size() + 1; ++pos) {
+      if (hay.find(searcher, pos) != shay.find("abcab", pos)
+       || hay.rfind(searcher, pos) != shay.rfind("abcab", pos)
+       || hay.find(bsearcher, pos) != shay.find(std::string(20, 'b'), pos)
+       || hay.rfind(bsearcher, pos) != shay.rfind(std::string(20, 'b'), pos)
+      ) {
+        throw_runtime_error("bad searcher");
+      }
+    }
+#ifdef __cpp_lib_boyer_moore_searcher
+    if (std::search(shay.begin(), shay.end(), searcher) != r.first) {
+      throw_runtime_error("bad searcher");
+    }
+#endif
+
+    for (char const * needle : needles) {
+      std::size_t const n = strlen(needle);
+      for (std::size_t pos = 0; pos <= hay.size() + 1; ++pos) {
+        if (hay.find(needle, pos, n) != shay.find(needle, pos, n)) {
+          throw_runtime_error(std::string("bad find: ") + needle);
+        }
+        if (hay.rfind(needle, pos, n) != shay.rfind(needle, pos, n)) {
+          throw_runtime_error(std::string("bad rfind: ") + needle);
+        }
+      }
+      if (hay.rfind(needle) != shay.rfind(needle)) {
+        throw_runtime_error(std::string("bad rfind: ") + needle);
+      }
+    }
+  }
+
+  constexpr auto cd_charset = make_string_literal_charset(lit("cd"));
+  constexpr auto xyz_charset = make_string_literal_charset(lit("xyz"));
+  constexpr auto abcd_charset = make_string_literal_charset(lit("abcd"));
+  constexpr auto e_charset = make_string_literal_charset(s9);
+
+  u_<s7.find_first_of(cd_charset)>{} = u_<2>{};
+  u_<s7.find_first_of(xyz_charset)>{} = npos;
+  u_<s7.find_first_of(cd_charset, 3)>{} = u_<3>{};
+  u_<s7.find_first_of(e_charset)>{} = npos;
+
+  u_<s7.find_last_of(cd_charset)>{} = u_<8>{};
+  u_<s7.find_last_of(xyz_charset)>{} = npos;
+  u_<s7.find_last_of(cd_charset, 3)>{} = u_<3>{};
+
+  u_<s7.find_first_not_of(cd_charset)>{} = u_<0>{};
+  u_<s7.find_first_not_of(xyz_charset)>{} = u_<0>{};
+  u_<s7.find_first_not_of(abcd_charset, 3)>{} = u_<4>{};
+  u_<s7.find_first_not_of(e_charset, 3)>{} = u_<3>{};
+
+  u_<s7.find_last_not_of(cd_charset)>{} = u_<7>{};
+  u_<s7.find_last_not_of(xyz_charset)>{} = u_<8>{};
+  u_<s7.find_last_not_of(abcd_charset, 7)>{} = u_<5>{};
+  u_<s7.find_last_not_of(abcd_charset, 3)>{} = npos;
+
+  {
+    // runtime path of basic_string_literal_charset
+    auto const str = lit<40>('a') + "\t" + lit<30>('a') + "\xff,;" + lit<20>('b')
+      + " x" + lit<40>('a');
+    std::string const sstr = str.to_string();
+    constexpr auto sep_charset = make_string_literal_charset(lit(" ,;\t\xff"));
+    constexpr auto a_charset = make_string_literal_charset(lit("a"));
+    constexpr auto ab_charset = make_string_literal_charset(lit("ab"));
+    for (std::size_t pos = 0; pos <= str.size() + 1; ++pos) {
+      if (str.find_first_of(sep_charset, pos) != sstr.find_first_of(" ,;\t\xff", pos)
+       || str.find_last_of(sep_charset, pos) != sstr.find_last_of(" ,;\t\xff", pos)
+       || str.find_first_not_of(a_charset, pos) != sstr.find_first_not_of('a', pos)
+       || str.find_last_not_of(a_charset, pos) != sstr.find_last_not_of('a', pos)
+       || str.find_first_not_of(ab_charset, pos) != sstr.find_first_not_of("ab", pos)
+       || str.find_last_not_of(ab_charset, pos) != sstr.find_last_not_of("ab", pos)
+      ) {
+        throw_runtime_error("bad charset");
+      }
+    }
+
+    constexpr auto u32_charset = make_string_literal_charset(lit(U"b\u1234"));
+    static_assert(u32_charset.contains(U'\u1234'), "");
+    static_assert(!u32_charset.contains(U'\u1235'), "");
+    static_assert(!u32_charset.contains(U'a'), "");
+    static_assert(lit(U"aa\u1234").find_first_of(u32_charset) == 2, "");
+  }
+
+  {
+    constexpr auto matcher = make_string_literal_matcher(
+      lit("GET"), lit("POST"), lit("HEAD"), lit("he"), lit("she"),
+      lit("hers"), lit("his"));
+    static_assert(matcher.size() == 7, "");
+    static_assert(matcher.states() == 21, "");
+    static_assert(matcher.class_of('z') == 0, "");
+    static_assert(matcher.find(lit("xxPOSTxx")).index == 1, "");
+    static_assert(matcher.find(lit("xxPOSTxx")).pos == 2, "");
+    static_assert(matcher.find(lit("ushers")).index == 4, "");
+    static_assert(matcher.find(lit("ushers")).pos == 1, "");
+    static_assert(matcher.find(lit("ushers"), 2).index == 3, "");
+    static_assert(matcher.find(lit("ushers"), 2).pos == 2, "");
+    static_assert(!matcher.find(lit("GEPOS")), "");
+
+    std::string const line = "xx HEAD his shers";
+    std::string found;
+    matcher.for_each_match(line.data(), line.size(),
+      [&](std::size_t index, std::size_t pos) {
+        found += std::to_string(index) + ":" + std::to_string(pos) + " ";
+      });
+    if (found != "2:3 6:8 4:12 3:13 5:13 ") {
+      throw_runtime_error("bad matcher: " + found);
+    }
+    auto const m = matcher.find(line.data(), line.size());
+    if (m.index != 2 || m.pos != 3) {
+      throw_runtime_error("bad matcher");
+    }
+
+    constexpr auto wmatcher = make_string_literal_matcher(
+      lit(u"\u1234a"), lit(u""), lit(u"b"));
+    static_assert(wmatcher.find(lit(u"x"), 1).index == 1, "");
+    static_assert(wmatcher.find(lit(u"x"), 2).index == wmatcher.npos, "");
+    static_assert(make_string_literal_matcher(lit(u"\u1234a"), lit(u"b"))
+      .find(lit(u"\u1234\u1234a")).pos == 1, "");
+  }
+
+  {
+    // runtime path of constexpr_std_char_traits
+    auto const str = lit<40>('a') + "\xe9" + lit<40>('b');
+    std::string const sstr = str.to_string();
+    char const * strs[] = {"", "a", "aab", "b", "\xe9", "aa\xe9", "zz"};
+    for (char const * cs : strs) {
+      int const r1 = sstr.compare(cs);
+      int const r2 = str.compare(cs);
+      if ((r1 < 0) != (r2 < 0) || (r1 > 0) != (r2 > 0)) {
+        throw_runtime_error(std::string("bad compare: ") + cs);
+      }
+    }
+    if (str.compare(lit<40>('a') + "\x7f") != 1
+     || str.compare(0, 41, lit<40>('a') + "\xff") != -1
+     || str.find('\xe9') != 40
+     || str.find('c') != str.npos
+     || str.find_first_of("\xe9" "c") != 40
+     || str.find("b", 45) != 45
+     || str != str.to_string().c_str()
+    ) {
+      throw_runtime_error("bad runtime traits");
+    }
+  }
+
+  {
+    constexpr auto keys = falcon::make_string_literal_set(
+      lit("host"), lit("port"), lit("user"), lit(""), lit("password"),
+      lit("timeout"), lit("retries"), lit("log_level"), lit("log_file"));
+    static_assert(keys.size() == 9, "");
+    static_assert(keys.index_of(lit("host")) == 0, "");
+    static_assert(keys.index_of(lit("")) == 3, "");
+    static_assert(keys.index_of(lit("log_file")) == 8, "");
+    static_assert(keys.index_of(lit("log_fil")) == keys.npos, "");
+    static_assert(keys.contains(lit("timeout")), "");
+    static_assert(!keys.contains(lit("timeouts")), "");
+
+    constexpr auto map = falcon::make_string_literal_map(
+      std::make_pair(lit("GET"), 1), std::make_pair(lit("POST"), 2),
+      std::make_pair(lit("PUT"), 3), std::make_pair(lit("DELETE"), 4));
+    static_assert(*map.find(lit("PUT")) == 3, "");
+    static_assert(!map.find(lit("PATCH")), "");
+
+    std::string const names[] = {"GET", "POST", "PUT", "DELETE", "HEAD", "", "GE"};
+    int const values[] = {1, 2, 3, 4, 0, 0, 0};
+    for (std::size_t i = 0; i < 7; ++i) {
+      int const * p = map.find(names[i].data(), names[i].size());
+      if ((p ? *p : 0) != values[i]) {
+        throw_runtime_error("bad map: " + names[i]);
+      }
+    }
+
+    constexpr auto empty = falcon::make_string_literal_set<char, std::char_traits<char>>();
+    static_assert(!empty.contains(lit("")), "");
+    constexpr auto one = falcon::make_string_literal_set(lit("a"));
+    static_assert(one.contains(lit("a")) && !one.contains(lit("b")), "");
+
+#ifdef __cpp_exceptions
+    bool duplicate_keys = false;
+    try {
+      falcon::make_string_literal_set(lit("GET"), lit("PUT"), lit("GET"));
+    }
+    catch (std::invalid_argument const &) {
+      duplicate_keys = true;
+    }
+    if (!duplicate_keys) {
+      throw_runtime_error("bad make_string_literal_set");
+    }
+#endif
+  }
+
+  {
+    constexpr auto commands = falcon::make_string_switch(
+      lit("start"), lit("stop"), lit("restart"), lit(""), lit("status"));
+    static_assert(commands("stop") == falcon::string_id("stop"), "");
+    static_assert(commands("") == falcon::string_id(""), "");
+    static_assert(commands("sto") == commands.no_match, "");
+    static_assert(commands.index_of("status", 6) == 4, "");
+    static_assert(commands.index_of("statu", 5) == commands.npos, "");
+
+    auto dispatch = [&](std::string const & cmd) {
+      switch (commands(cmd.data(), cmd.size())) {
+        case falcon::string_id("start"): return 1;
+        case falcon::string_id("stop"): return 2;
+        case falcon::string_id("restart"): return 3;
+        case falcon::string_id(""): return 4;
+        case falcon::string_id("status"): return 5;
+        default: return 0;
+      }
+    };
+    if (dispatch("start") != 1 || dispatch("restart") != 3
+     || dispatch("") != 4 || dispatch("starts") != 0 || dispatch("x") != 0) {
+      throw_runtime_error("bad string_switch");
+    }
+
+#ifdef __cpp_exceptions
+    bool colliding_labels = false;
+    try {
+      falcon::make_string_switch(lit("start"), lit("stop"), lit("start"));
+    }
+    catch (std::invalid_argument const &) {
+      colliding_labels = true;
+    }
+    if (!colliding_labels) {
+      throw_runtime_error("bad make_string_switch");
+    }
+#endif
+  }
+
+  {
+    constexpr auto request_line = falcon::make_string_literal_format(
+      lit("GET {} HTTP/1.1\r\n"));
+    static_assert(request_line.arity() == 1, "");
+    static_assert(request_line.constant_size() == 15, "");
+    static_assert(request_line.segment_size(0) == 4, "");
+    static_assert(request_line.segment_size(1) == 11, "");
+    static_assert(request_line.formatted_size(abc) == 18, "");
+
+    constexpr auto braces = falcon::make_string_literal_format(
+      lit("{{{}}}:{}{}, }}{{"));
+    static_assert(braces.arity() == 3, "");
+    static_assert(braces.constant_size() == 7, "");
+    static_assert(braces.segment_size(2) == 0, "");
+    static_assert(braces.formatted_size(-120, 'c', "ab") == 14, "");
+
+    constexpr auto no_slot = falcon::make_string_literal_format(lit("abc"));
+    static_assert(no_slot.arity() == 0, "");
+    static_assert(no_slot.formatted_size() == 3, "");
+
+    if (request_line.format(std::string("/index.html"))
+      != "GET /index.html HTTP/1.1\r\n") {
+      throw_runtime_error("bad string_literal_format");
+    }
+    if (braces.format(-120, 'c', s3) != "{-120}:cabcdef, }{") {
+      throw_runtime_error("bad string_literal_format");
+    }
+    if (braces.format(0u, '0', "") != "{0}:0, }{"
+     || braces.format(18446744073709551615ull, ' ', abc)
+        != "{18446744073709551615}: abc, }{") {
+      throw_runtime_error("bad string_literal_format");
+    }
+    char buf[32]{};
+    char * const end = request_line.format_to(buf, lit("/"));
+    if (end - buf != 16 || std::string(buf) != "GET / HTTP/1.1\r\n") {
+      throw_runtime_error("bad string_literal_format");
+    }
+#ifdef __cpp_exceptions
+    bool bad_count = false;
+    try {
+      request_line.format(abc, abc);
+    }
+    catch (std::invalid_argument const &) {
+      bad_count = true;
+    }
+    if (!bad_count) {
+      throw_runtime_error("bad string_literal_format");
+    }
+#endif
+
+    static_assert(brace_pos == 2, "");
+    static_assert(status_line.arity() == 2, "");
+    if (status_line.format(404, lit("Not Found"))
+      != "HTTP/1.1 404 Not Found\r\n") {
+      throw_runtime_error("bad string_literal_format");
+    }
+  }
+
+  {
+    falcon::deferred_log_registry registry;
+    auto const login = registry.add<int, char const *>(
+      lit("user {} logged from {}"));
+    auto const stop = registry.add<unsigned char, falcon::string_literal<3>>(
+      lit("stop {}{{{}}}"));
+    auto const no_arg = registry.add<>(lit("no argument"));
+    if (login.id != falcon::string_id(lit("user {} logged from {}"))
+     || registry.add<int, char const *>(lit("user {} logged from {}")).id
+        != login.id
+     || registry.size() != 3) {
+      throw_runtime_error("bad deferred_log_registry");
+    }
+
+    // small buffer: records wrap around
+    falcon::deferred_log_buffer buffer{64};
+    std::vector<std::string> messages;
+    auto push_message = [&](std::string const & msg) {
+      messages.push_back(msg);
+    };
+    std::string const host = "localhost";
+    for (int i = 0; i < 10; ++i) {
+      if (!buffer.log(login, i - 3, host.c_str())
+       || !buffer.log(stop, static_cast<unsigned char>(i), abc)
+       || !buffer.log(no_arg)) {
+        throw_runtime_error("bad deferred_log_buffer::log");
+      }
+      if (3 != buffer.consume(registry, push_message)) {
+        throw_runtime_error("bad deferred_log_buffer::consume");
+      }
+    }
+    if (messages.size() != 30
+     || messages[0] != "user -3 logged from localhost"
+     || messages[28] != "stop 9{abc}"
+     || messages[29] != "no argument") {
+      throw_runtime_error("bad deferred_log_buffer");
+    }
+
+    while (buffer.log(no_arg)) {
+    }
+    if (buffer.dropped() != 1 || buffer.capacity() != 64) {
+      throw_runtime_error("bad deferred_log_buffer::dropped");
+    }
+    std::size_t unknown = 0;
+    buffer.consume([&](std::size_t id, unsigned char const * p, std::size_t n) {
+      std::string msg;
+      unknown += !registry.decode(id + 1, p, n, msg);
+    });
+    if (unknown != 5) {
+      throw_runtime_error("bad deferred_log_registry::decode");
+    }
+
+    {
+      // offline dictionary: the size of a payload from the argument descriptions
+      std::unordered_map<std::size_t, std::vector<falcon::deferred_log_arg_desc>> dict;
+      registry.for_each([&](
+        std::size_t id, std::string const & fmt,
+        std::vector<falcon::deferred_log_arg_desc> const & args) {
+        if (fmt.empty()) {
+          throw_runtime_error("bad deferred_log_registry::for_each");
+        }
+        dict[id] = args;
+      });
+      auto const & login_args = dict[login.id];
+      if (dict.size() != 3 || login_args.size() != 2 || !dict[no_arg.id].empty()
+       || login_args[0].type != falcon::deferred_log_arg_type::signed_integer
+       || login_args[0].size != sizeof(int)
+       || login_args[1].type != falcon::deferred_log_arg_type::string
+       || login_args[1].size != 1
+       || dict[stop.id][0].type != falcon::deferred_log_arg_type::unsigned_integer) {
+        throw_runtime_error("bad deferred_log_registry::for_each");
+      }
+
+      buffer.log(login, 42, host.c_str());
+      buffer.log(stop, static_cast<unsigned char>(1), abc);
+      std::size_t decoded = 0;
+      buffer.consume([&](std::size_t id, unsigned char const * p, std::size_t n) {
+        std::size_t pos = 0;
+        for (auto const & arg : dict[id]) {
+          if (arg.type == falcon::deferred_log_arg_type::string) {
+            std::uint32_t len;
+            std::memcpy(&len, p + pos, sizeof(len));
+            pos += sizeof(len) + len * arg.size;
+          }
+          else {
+            pos += arg.size;
+          }
+        }
+        decoded += pos == n;
+      });
+      if (decoded != 2) {
+        throw_runtime_error("bad deferred_log_arg_desc");
+      }
+    }
+
+    {
+      // truncated or corrupt payloads
+      std::string msg;
+      unsigned char payload[16] {};
+      std::uint32_t const too_long = 100;
+      std::memcpy(payload + sizeof(int), &too_long, sizeof(too_long));
+      if (registry.decode(login.id, payload, 2, msg)
+       || registry.decode(login.id, payload, sizeof(int) + 2, msg)
+       || registry.decode(login.id, payload, sizeof(payload), msg)
+       || registry.decode(no_arg.id, payload, 1, msg)
+       || !registry.decode(no_arg.id, payload, 0, msg)
+       || msg != "no argument") {
+        throw_runtime_error("bad deferred_log_registry::decode");
+      }
+    }
+
+    {
+      // wide characters after a char (an integer here) are not aligned in the record
+      falcon::wdeferred_log_registry wregistry;
+      auto const wsite = wregistry.add<char, wchar_t const *>(lit(L"{}={}"));
+      falcon::wdeferred_log_buffer wbuffer{256};
+      std::wstring wmsg;
+      if (!wbuffer.log(wsite, char{7}, L"value")
+       || 1 != wbuffer.consume(wregistry, [&](std::wstring const & msg) {
+            wmsg = msg;
+          })
+       || wmsg != L"7=value") {
+        throw_runtime_error("bad wdeferred_log_buffer");
+      }
+    }
+
+#ifdef __cpp_exceptions
+    bool bad_arity = false;
+    try {
+      registry.add<int>(lit("{} {}"));
+    }
+    catch (std::invalid_argument const &) {
+      bad_arity = true;
+    }
+    if (!bad_arity) {
+      throw_runtime_error("bad deferred_log_registry::add");
+    }
+
+    bool bad_signature = false;
+    try {
+      registry.add<char const *, char const *>(lit("user {} logged from {}"));
+    }
+    catch (std::invalid_argument const &) {
+      bad_signature = true;
+    }
+    if (!bad_signature || registry.size() != 3) {
+      throw_runtime_error("bad deferred_log_registry::add");
+    }
+#endif
+  }
+
   if ("abcdefabc" != s7.to_string()) {
     throw_runtime_error("bad to_string");
   }
@@ -305,6 +1369,56 @@ inline void check()
   u_<falcon::string_id(s7)>{} = u_<16785409650144737470ull>{};
   u_<falcon::string_id(s3)>{} = u_<15567776504244095498ull>{};
 
+  {
+    constexpr auto hs7 = falcon::make_hashed_string_literal(s7);
+    u_<hs7.hash()>{} = u_<16785409650144737470ull>{};
+    u_<falcon::string_id(hs7)>{} = u_<16785409650144737470ull>{};
+    u_<std::hash<falcon::hashed_string_literal<9>>{}(hs7)>{} = u_<16785409650144737470ull>{};
+    static_assert(hs7 == s7, "");
+    static_assert(hs7.find(abc, 1) == 6, "");
+    static_assert(falcon::make_hashed_string_literal("abcdef") == s3, "");
+    if (std::hash<string_literal<9>>{}(s7) != hs7.hash()) {
+      throw_runtime_error("bad hash");
+    }
+    std::unordered_set<falcon::hashed_string_literal<3>> set{
+      falcon::make_hashed_string_literal("abc"),
+      falcon::make_hashed_string_literal("def"),
+    };
+    if (!set.count(falcon::make_hashed_string_literal(abc)) || set.size() != 2) {
+      throw_runtime_error("bad hashed_string_literal");
+    }
+  }
+
+  {
+    constexpr auto long_s = s7 + s7 + s7 + abc;
+    constexpr auto h = falcon::wymum_64_fn{}(long_s.begin(), long_s.end());
+    u_<h>{} = u_<falcon::wymum_64_fn{}(long_s.begin(), long_s.end())>{};
+    static_assert(falcon::wymum_64_fn{}(s7.begin(), s7.end())
+      != falcon::wymum_64_fn{}(s3.begin(), s3.end()), "");
+    static_assert(falcon::wymum_fn<1>{}(s7.begin(), s7.end())
+      != falcon::wymum_64_fn{}(s7.begin(), s7.end()), "");
+    std::string const str = long_s.to_string();
+    if (falcon::wymum_64_fn{}(long_s.begin(), long_s.end()) != h
+     || falcon::wymum_64_fn{}(str.begin(), str.end()) != h
+     || falcon::wymum_hash<std::string>{}(str) != std::size_t(h)) {
+      throw_runtime_error("bad wymum hash");
+    }
+    constexpr auto u16 = falcon::make_string_literal(u"abcdefghij");
+    constexpr auto hu16 = falcon::wymum_64_fn{}(u16.begin(), u16.end());
+    std::u16string const ustr = u16.to_string();
+    if (falcon::wymum_64_fn{}(ustr.data(), ustr.data() + ustr.size()) != hu16) {
+      throw_runtime_error("bad wymum hash");
+    }
+    for (std::size_t n = 0; n <= str.size(); ++n) {
+      auto const first = str.data();
+      std::uint64_t hp = falcon::wymum_64_fn{}(first, first + n);
+      std::uint64_t hi = falcon::wymum_64_fn{}(str.begin(), str.begin() + long(n));
+      if (hp != hi) {
+        throw_runtime_error("bad wymum hash");
+      }
+    }
+  }
+
 
   std::ostringstream oss;
   auto oss_cmp = [&](char const * s) {
@@ -323,6 +1437,60 @@ inline void check()
   oss.str(""); oss << abc;
   oss_cmp("abc");
 
+  oss.str(""); oss << std::right << std::setw(203) << std::setfill('*') << abc;
+  oss_cmp((std::string(200, '*') + "abc").c_str());
+
+  oss.str(""); oss << std::left << std::setw(133) << std::setfill('-') << abc;
+  oss_cmp(("abc" + std::string(130, '-')).c_str());
+
+  oss.str(""); falcon::iostreams::ostream_fill(oss, 64, '=');
+  oss_cmp(std::string(64, '=').c_str());
+
+  oss.str(""); falcon::iostreams::ostream_fill(oss, 3, '=');
+  oss_cmp("===");
+
+  {
+    std::string const str = "[runtime]";
+    std::string const empty;
+    falcon::iostreams::gather_writer<4> writer;
+    writer << abc << str << s7 << empty;
+    if (writer.size() != 3 || writer.bytes() != 3 + 9 + 9 || !writer.good()) {
+      throw_runtime_error("bad gather_writer");
+    }
+
+    oss.str(""); falcon::iostreams::ostream_write(oss, writer);
+    oss_cmp("abc[runtime]abcdefabc");
+
+#ifdef FALCON_IOSTREAMS_HAS_WRITEV
+    int fds[2];
+    if (pipe(fds)) {
+      throw_runtime_error("pipe");
+    }
+    bool const written = writer.write_to(fds[1]);
+    close(fds[1]);
+    char buf[64]{};
+    auto const n = read(fds[0], buf, sizeof(buf));
+    close(fds[0]);
+    if (!written || n != 21 || std::string(buf) != "abc[runtime]abcdefabc") {
+      throw_runtime_error("bad gather_writer::write_to(fd)");
+    }
+#endif
+
+    writer << abc << abc;
+    if (writer.good() || writer.size() != 4) {
+      throw_runtime_error("bad gather_writer");
+    }
+    oss.str(""); writer.write_to(oss);
+    if (!oss.fail()) {
+      throw_runtime_error("bad gather_writer");
+    }
+    oss.clear();
+    writer.clear();
+    if (!writer.good() || !writer.empty() || writer.bytes()) {
+      throw_runtime_error("bad gather_writer");
+    }
+  }
+
   oss.str(""); oss.setstate(std::ios::failbit); oss << abc;
   oss_cmp("");
 }